@@ -1,5 +1,4 @@
 #include "Background.h"
-#include "System.h"
 #include "Graphics.h"
 #include "ImmediateMode.h"
 #include "Random.h"
@@ -17,15 +16,11 @@ Background::Background(float width, float height)
 	}
 }
 
-void Background::Update(System *systems)
-{
-}
-
 void Background::Render(Graphics *graphics) const
 {
 	graphics->ClearFrame(0.0f, 0.0f, 0.0f, 0.0f);
 
-	graphics->GetImmediateMode()->Draw(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST,
+	graphics->GetImmediateMode()->Draw(RENDER_TOPOLOGY_POINT_LIST,
 		&stars_[0],
 		NUM_STARS);
 }
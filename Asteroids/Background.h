@@ -1,21 +1,21 @@
 #ifndef BACKGROUND_H_INCLUDED
 #define BACKGROUND_H_INCLUDED
 
-#include "GameEntity.h"
 #include "ImmediateModeVertex.h"
 
-class Background : public GameEntity
+class Graphics;
+
+class Background
 {
 public:
+	enum { NUM_STARS = 256 };
+
 	Background(float width, float height);
 
-	void Update(System *system);
 	void Render(Graphics *graphics) const;
 
 private:
 
-	enum { NUM_STARS = 256 };
-
 	ImmediateModeVertex stars_[NUM_STARS];
 
 };
@@ -0,0 +1,458 @@
+#include "D3D11RenderDevice.h"
+#include "DynamicVertexBuffers.h"
+#include "VertexShader.h"
+#include "PixelShader.h"
+#include "MatrixBuffer.h"
+#include "ResourceLoader.h"
+#include "ImmediateModeVertex.h"
+#include "SpriteFontVertex.h"
+#include "SpriteFontRenderer.h"
+#include "resource.h"
+#include <SpriteFont.h>
+
+namespace
+{
+	D3D11_PRIMITIVE_TOPOLOGY GetD3D11Topology(RenderTopology topology)
+	{
+		switch (topology)
+		{
+		case RENDER_TOPOLOGY_POINT_LIST: return D3D11_PRIMITIVE_TOPOLOGY_POINTLIST;
+		case RENDER_TOPOLOGY_LINE_LIST: return D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
+		case RENDER_TOPOLOGY_LINE_STRIP: return D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP;
+		case RENDER_TOPOLOGY_TRIANGLE_LIST: return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+		case RENDER_TOPOLOGY_TRIANGLE_STRIP: return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+		default: return D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+		}
+	}
+
+	class D3D11RenderFont : public RenderFont
+	{
+	public:
+		D3D11RenderFont(ID3D11Device *d3dDevice, const ResourceLoader::Resource &resource) :
+			sprite_(d3dDevice, static_cast<const uint8_t *>(resource.data), resource.size),
+			textureView_(0)
+		{
+			sprite_.GetSpriteSheet(&textureView_);
+		}
+
+		virtual ~D3D11RenderFont()
+		{
+			textureView_->Release();
+		}
+
+		virtual void BuildText(const char *text,
+			float x,
+			float y,
+			uint32_t colour,
+			std::vector<SpriteFontVertex> *vertices) const
+		{
+			SpriteFontRenderer renderer(colour, vertices);
+			sprite_.DrawString(&renderer, text, XMVectorSet(x, y, 0.0f, 0.0f), XMVectorZero());
+		}
+
+		virtual float GetLineSpacing() const
+		{
+			return sprite_.GetLineSpacing();
+		}
+
+		virtual float MeasureWidth(const char *text) const
+		{
+			return XMVectorGetX(sprite_.MeasureString(text));
+		}
+
+		virtual RenderTexture GetTexture() const
+		{
+			return textureView_;
+		}
+
+	private:
+		DirectX::SpriteFont sprite_;
+		ID3D11ShaderResourceView *textureView_;
+	};
+}
+
+D3D11RenderDevice::D3D11RenderDevice(const InitialisationParams &initParams) :
+	dxgiSwapChain_(initParams.dxgiSwapChain),
+	d3dDevice_(initParams.d3dDevice),
+	d3dDeviceContext_(initParams.d3dDeviceContext),
+	d3dRenderTargetView_(initParams.d3dRenderTargetView),
+	binaryResources_(initParams.binaryResources),
+	textureSampler_(0)
+{
+	defaultViewport_.TopLeftX = 0;
+	defaultViewport_.TopLeftY = 0;
+	defaultViewport_.Width = 800;
+	defaultViewport_.Height = 600;
+	defaultViewport_.MinDepth = 0.0f;
+	defaultViewport_.MaxDepth = 1.0f;
+
+	ZeroMemory(pipelines_, sizeof(pipelines_));
+}
+
+D3D11RenderDevice::~D3D11RenderDevice()
+{
+}
+
+D3D11RenderDevice *D3D11RenderDevice::CreateDevice(HWND window, ResourceLoader *binaryResources)
+{
+	// Create the basic D3D devices
+	DXGI_SWAP_CHAIN_DESC swapChainDesc;
+	ZeroMemory(&swapChainDesc, sizeof(swapChainDesc));
+	swapChainDesc.BufferDesc.Width = 800;
+	swapChainDesc.BufferDesc.Height = 600;
+	swapChainDesc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	swapChainDesc.SampleDesc.Count = 1;
+	swapChainDesc.SampleDesc.Quality = 0;
+	swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+	swapChainDesc.BufferCount = 1;
+	swapChainDesc.OutputWindow = window;
+	swapChainDesc.Windowed = TRUE;
+	swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
+
+	IDXGISwapChain *dxgiSwapChain;
+	ID3D11Device *d3dDevice;
+	ID3D11DeviceContext *d3dDeviceContext;
+
+	const D3D_FEATURE_LEVEL requiredFeatureLevel = D3D_FEATURE_LEVEL_11_0;
+	HRESULT createDevice = D3D11CreateDeviceAndSwapChain(
+		NULL, // Default adapter
+		D3D_DRIVER_TYPE_WARP, // Force a slow path to make sure we're working with a known reference
+		//D3D_DRIVER_TYPE_HARDWARE, // Force a slow path to make sure we're working with a known reference
+		NULL, // Software rasteriser unused
+		D3D11_CREATE_DEVICE_BGRA_SUPPORT | D3D11_CREATE_DEVICE_DEBUG,
+		&requiredFeatureLevel,
+		1,
+		D3D11_SDK_VERSION,
+		&swapChainDesc,
+		&dxgiSwapChain,
+		&d3dDevice,
+		NULL, // We only passed one feature level, so it either succeeded or failed
+		&d3dDeviceContext);
+
+	if (FAILED(createDevice))
+	{
+		return 0;
+	}
+
+	ID3D11Resource *backBuffer;
+	HRESULT getBackBuffer = dxgiSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<void **>(&backBuffer));
+	if (FAILED(getBackBuffer))
+	{
+		d3dDeviceContext->Release();
+		d3dDevice->Release();
+		dxgiSwapChain->Release();
+		return 0;
+	}
+
+	D3D11_RENDER_TARGET_VIEW_DESC viewDesc;
+	ZeroMemory(&viewDesc, sizeof(viewDesc));
+	viewDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	viewDesc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
+	viewDesc.Texture2D.MipSlice = 0;
+
+	ID3D11RenderTargetView *d3dRenderTargetView;
+	HRESULT createRenderTargetView = d3dDevice->CreateRenderTargetView(
+		backBuffer,
+		&viewDesc,
+		&d3dRenderTargetView);
+	backBuffer->Release();
+
+	if (FAILED(createRenderTargetView))
+	{
+		d3dDeviceContext->Release();
+		d3dDevice->Release();
+		dxgiSwapChain->Release();
+		return 0;
+	}
+
+	//  Create our render device
+	InitialisationParams deviceParams;
+	deviceParams.dxgiSwapChain = dxgiSwapChain;
+	deviceParams.d3dDevice = d3dDevice;
+	deviceParams.d3dDeviceContext = d3dDeviceContext;
+	deviceParams.d3dRenderTargetView = d3dRenderTargetView;
+	deviceParams.binaryResources = binaryResources;
+
+	D3D11RenderDevice *newDevice = new D3D11RenderDevice(deviceParams);
+
+	bool loadDefaultResources = newDevice->CreateResources(binaryResources);
+	if (loadDefaultResources == false)
+	{
+		DestroyDevice(newDevice);
+		return 0;
+	}
+
+	return newDevice;
+}
+
+void D3D11RenderDevice::DestroyDevice(D3D11RenderDevice *device)
+{
+	if (device == 0)
+		return;
+
+	device->DestroyResources();
+
+	device->d3dRenderTargetView_->Release();
+	device->d3dDeviceContext_->Release();
+	device->d3dDevice_->Release();
+	device->dxgiSwapChain_->Release();
+
+	delete device;
+}
+
+void D3D11RenderDevice::BeginFrame()
+{
+	d3dDeviceContext_->RSSetViewports(1, &defaultViewport_);
+
+	for (int pipeline = 0; pipeline < RENDER_PIPELINE_COUNT; ++pipeline)
+	{
+		pipelines_[pipeline].vertexBuffers->BeginFrame();
+	}
+}
+
+void D3D11RenderDevice::EndFrame()
+{
+	for (int pipeline = 0; pipeline < RENDER_PIPELINE_COUNT; ++pipeline)
+	{
+		pipelines_[pipeline].vertexBuffers->EndFrame();
+	}
+
+	d3dDeviceContext_->ClearState();
+	dxgiSwapChain_->Present(1, 0);
+}
+
+void D3D11RenderDevice::ClearFrame(float r, float g, float b, float a)
+{
+	const float rgba[4] = { r, g, b, a };
+	d3dDeviceContext_->ClearRenderTargetView(
+		d3dRenderTargetView_,
+		rgba);
+
+	d3dDeviceContext_->OMSetRenderTargets(1, &d3dRenderTargetView_, NULL);
+}
+
+bool D3D11RenderDevice::Draw(RenderPipeline pipeline,
+	RenderTopology topology,
+	const RenderMatrices &matrices,
+	RenderTexture texture,
+	const void *vertices,
+	unsigned int vertexCount)
+{
+	const Pipeline &state = pipelines_[pipeline];
+
+	// Copy dynamic vertex data
+	DynamicVertexBuffers::VertexRange copiedRange;
+	bool copiedVerts = state.vertexBuffers->CopyVertexData(vertices,
+		GetVertexSize(pipeline),
+		vertexCount,
+		d3dDeviceContext_,
+		&copiedRange);
+	if (copiedVerts == false)
+	{
+		return false;
+	}
+
+	// Set up our shaders
+	state.vertexShader->VSSetShader(d3dDeviceContext_);
+	state.pixelShader->PSSetShader(d3dDeviceContext_);
+
+	// Flush constant buffers
+	state.modelViewProjection->VSSetConstantBuffers(d3dDeviceContext_,
+		XMLoadFloat4x4(&matrices.model),
+		XMLoadFloat4x4(&matrices.view),
+		XMLoadFloat4x4(&matrices.projection));
+
+	if (texture != 0)
+	{
+		ID3D11ShaderResourceView *textureView = static_cast<ID3D11ShaderResourceView *>(texture);
+		d3dDeviceContext_->PSSetShaderResources(0, 1, &textureView);
+		d3dDeviceContext_->PSSetSamplers(0, 1, &textureSampler_);
+	}
+
+	// Issue draw command
+	d3dDeviceContext_->IASetPrimitiveTopology(GetD3D11Topology(topology));
+	state.vertexBuffers->IASetVertexBuffer(d3dDeviceContext_);
+	d3dDeviceContext_->Draw(vertexCount, copiedRange.begin);
+
+	return true;
+}
+
+RenderFont *D3D11RenderDevice::LoadFont(int resourceId)
+{
+	ResourceLoader::Resource fontResource;
+	if (binaryResources_->LoadResource(resourceId, &fontResource) == false)
+		return 0;
+
+	return new D3D11RenderFont(d3dDevice_, fontResource);
+}
+
+void D3D11RenderDevice::DestroyFont(RenderFont *font)
+{
+	delete font;
+}
+
+bool D3D11RenderDevice::CreateResources(ResourceLoader *binaryResources)
+{
+	bool createImmediateMode = CreateImmediateModePipeline(binaryResources);
+	bool createSpriteFont = CreateSpriteFontPipeline(binaryResources);
+	if ((createImmediateMode == false) ||
+		(createSpriteFont == false))
+	{
+		DestroyResources();
+		return false;
+	}
+
+	return true;
+}
+
+bool D3D11RenderDevice::CreateImmediateModePipeline(ResourceLoader *binaryResources)
+{
+	const unsigned int MAX_IMMEDIATE_MODE_VERTICES = 1 * 1024 * 1024;
+
+	ResourceLoader::Resource vertexShaderResource;
+	binaryResources->LoadResource(IDR_VERTEX_SHADER_FVF_XYZ_DIFFUSE, &vertexShaderResource);
+
+	ResourceLoader::Resource pixelShaderResource;
+	binaryResources->LoadResource(IDR_PIXEL_SHADER_FVF_XYZ_DIFFUSE, &pixelShaderResource);
+
+	Pipeline &pipeline = pipelines_[RENDER_PIPELINE_IMMEDIATE_MODE];
+	pipeline.vertexBuffers = DynamicVertexBuffers::CreateDynamicVertexBuffers<ImmediateModeVertex>(
+		MAX_IMMEDIATE_MODE_VERTICES,
+		2,
+		d3dDevice_);
+	pipeline.modelViewProjection = MatrixBuffer::CreateMatrixBuffer(d3dDevice_);
+
+	std::vector<D3D11_INPUT_ELEMENT_DESC> vertexLayout;
+	vertexLayout.resize(2);
+
+	vertexLayout[0].SemanticName = "POSITION";
+	vertexLayout[0].SemanticIndex = 0;
+	vertexLayout[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
+	vertexLayout[0].InputSlot = 0;
+	vertexLayout[0].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+	vertexLayout[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexLayout[0].InstanceDataStepRate = 0;
+
+	vertexLayout[1].SemanticName = "COLOR";
+	vertexLayout[1].SemanticIndex = 0;
+	vertexLayout[1].Format = DXGI_FORMAT_R8G8B8A8_UINT;
+	vertexLayout[1].InputSlot = 0;
+	vertexLayout[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+	vertexLayout[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexLayout[1].InstanceDataStepRate = 0;
+
+	pipeline.vertexShader = VertexShader::CreateVertexShader(
+		vertexShaderResource.data,
+		vertexShaderResource.size,
+		d3dDevice_,
+		vertexLayout);
+
+	pipeline.pixelShader = PixelShader::CreatePixelShader(
+		pixelShaderResource.data,
+		pixelShaderResource.size,
+		d3dDevice_);
+
+	return (pipeline.vertexBuffers != 0) &&
+		(pipeline.modelViewProjection != 0) &&
+		(pipeline.vertexShader != 0) &&
+		(pipeline.pixelShader != 0);
+}
+
+bool D3D11RenderDevice::CreateSpriteFontPipeline(ResourceLoader *binaryResources)
+{
+	const unsigned int MAXIMUM_GLYPHS = 64 * 1024;
+	const unsigned int MAXIMUM_FONT_VERTICES = 6 * MAXIMUM_GLYPHS;
+
+	bool resourcesLoaded = true;
+
+	ResourceLoader::Resource vertexShaderResource;
+	resourcesLoaded &= binaryResources->LoadResource(IDR_VERTEX_SHADER_SPRITEFONT, &vertexShaderResource);
+
+	ResourceLoader::Resource pixelShaderResource;
+	resourcesLoaded &= binaryResources->LoadResource(IDR_PIXEL_SHADER_SPRITEFONT, &pixelShaderResource);
+
+	Pipeline &pipeline = pipelines_[RENDER_PIPELINE_SPRITE_FONT];
+	pipeline.vertexBuffers = DynamicVertexBuffers::CreateDynamicVertexBuffers<SpriteFontVertex>(MAXIMUM_FONT_VERTICES,
+		2,
+		d3dDevice_);
+	pipeline.modelViewProjection = MatrixBuffer::CreateMatrixBuffer(d3dDevice_);
+
+	std::vector<D3D11_INPUT_ELEMENT_DESC> vertexLayout;
+	vertexLayout.resize(3);
+
+	vertexLayout[0].SemanticName = "POSITION";
+	vertexLayout[0].SemanticIndex = 0;
+	vertexLayout[0].Format = DXGI_FORMAT_R32G32_FLOAT;
+	vertexLayout[0].InputSlot = 0;
+	vertexLayout[0].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+	vertexLayout[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexLayout[0].InstanceDataStepRate = 0;
+
+	vertexLayout[1].SemanticName = "TEXCOORD";
+	vertexLayout[1].SemanticIndex = 0;
+	vertexLayout[1].Format = DXGI_FORMAT_R32G32_FLOAT;
+	vertexLayout[1].InputSlot = 0;
+	vertexLayout[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+	vertexLayout[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexLayout[1].InstanceDataStepRate = 0;
+
+	vertexLayout[2].SemanticName = "COLOR";
+	vertexLayout[2].SemanticIndex = 0;
+	vertexLayout[2].Format = DXGI_FORMAT_R8G8B8A8_UINT;
+	vertexLayout[2].InputSlot = 0;
+	vertexLayout[2].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+	vertexLayout[2].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	vertexLayout[2].InstanceDataStepRate = 0;
+
+	pipeline.vertexShader = VertexShader::CreateVertexShader(
+		vertexShaderResource.data,
+		vertexShaderResource.size,
+		d3dDevice_,
+		vertexLayout);
+
+	pipeline.pixelShader = PixelShader::CreatePixelShader(
+		pixelShaderResource.data,
+		pixelShaderResource.size,
+		d3dDevice_);
+
+	D3D11_SAMPLER_DESC samplerDesc;
+	samplerDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
+	samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	samplerDesc.MipLODBias = 0.0f;
+	samplerDesc.MaxAnisotropy = 1;
+	samplerDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+	samplerDesc.BorderColor[0] = 1.0f;
+	samplerDesc.BorderColor[1] = 1.0f;
+	samplerDesc.BorderColor[2] = 1.0f;
+	samplerDesc.BorderColor[3] = 1.0f;
+	samplerDesc.MinLOD = -FLT_MAX;
+	samplerDesc.MaxLOD = FLT_MAX;
+	d3dDevice_->CreateSamplerState(&samplerDesc, &textureSampler_);
+
+	return resourcesLoaded &&
+		(pipeline.vertexBuffers != 0) &&
+		(pipeline.modelViewProjection != 0) &&
+		(pipeline.vertexShader != 0) &&
+		(pipeline.pixelShader != 0);
+}
+
+void D3D11RenderDevice::DestroyResources()
+{
+	for (int pipeline = 0; pipeline < RENDER_PIPELINE_COUNT; ++pipeline)
+	{
+		Pipeline &state = pipelines_[pipeline];
+		DynamicVertexBuffers::DestroyDynamicVertexBuffers(state.vertexBuffers);
+		VertexShader::DestroyVertexShader(state.vertexShader);
+		PixelShader::DestroyPixelShader(state.pixelShader);
+		MatrixBuffer::DestroyMatrixBuffer(state.modelViewProjection);
+	}
+	ZeroMemory(pipelines_, sizeof(pipelines_));
+
+	if (textureSampler_)
+	{
+		textureSampler_->Release();
+		textureSampler_ = 0;
+	}
+}
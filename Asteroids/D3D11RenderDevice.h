@@ -0,0 +1,78 @@
+#ifndef D3D11RENDERDEVICE_H_INCLUDED
+#define D3D11RENDERDEVICE_H_INCLUDED
+
+#include "RenderDevice.h"
+#include <d3d11.h>
+
+class ResourceLoader;
+class DynamicVertexBuffers;
+class VertexShader;
+class PixelShader;
+class MatrixBuffer;
+
+class D3D11RenderDevice : public RenderDevice
+{
+public:
+	static D3D11RenderDevice *CreateDevice(HWND window, ResourceLoader *binaryResources);
+	static void DestroyDevice(D3D11RenderDevice *device);
+
+	virtual void BeginFrame();
+	virtual void EndFrame();
+
+	virtual void ClearFrame(float r, float g, float b, float a);
+
+	virtual bool Draw(RenderPipeline pipeline,
+		RenderTopology topology,
+		const RenderMatrices &matrices,
+		RenderTexture texture,
+		const void *vertices,
+		unsigned int vertexCount);
+
+	virtual RenderFont *LoadFont(int resourceId);
+	virtual void DestroyFont(RenderFont *font);
+
+private:
+
+	struct InitialisationParams
+	{
+		IDXGISwapChain * dxgiSwapChain;
+		ID3D11Device *d3dDevice;
+		ID3D11DeviceContext *d3dDeviceContext;
+		ID3D11RenderTargetView *d3dRenderTargetView;
+		ResourceLoader *binaryResources;
+	};
+
+	struct Pipeline
+	{
+		DynamicVertexBuffers *vertexBuffers;
+		VertexShader *vertexShader;
+		PixelShader *pixelShader;
+		MatrixBuffer *modelViewProjection;
+	};
+
+	D3D11RenderDevice(const InitialisationParams &initParams);
+	~D3D11RenderDevice();
+
+	D3D11RenderDevice(const D3D11RenderDevice &);
+	void operator=(const D3D11RenderDevice &);
+
+	bool CreateResources(ResourceLoader *binaryResources);
+	bool CreateImmediateModePipeline(ResourceLoader *binaryResources);
+	bool CreateSpriteFontPipeline(ResourceLoader *binaryResources);
+	void DestroyResources();
+
+	IDXGISwapChain *dxgiSwapChain_;
+
+	ID3D11Device *d3dDevice_;
+	ID3D11DeviceContext *d3dDeviceContext_;
+	ID3D11RenderTargetView *d3dRenderTargetView_;
+
+	ResourceLoader *binaryResources_;
+
+	D3D11_VIEWPORT defaultViewport_;
+
+	Pipeline pipelines_[RENDER_PIPELINE_COUNT];
+	ID3D11SamplerState *textureSampler_;
+};
+
+#endif // D3D11RENDERDEVICE_H_INCLUDED
@@ -1,31 +1,22 @@
 #ifndef FONTENGINE_H_INCLUDED
 #define FONTENGINE_H_INCLUDED
 
-#include <d3d11.h>
+#include "RenderDevice.h"
+#include "SpriteFontVertex.h"
 #include <DirectXMath.h>
 #include <string>
 #include <map>
+#include <vector>
 
 using namespace DirectX;
 
-namespace DirectX
-{
-	class SpriteFont;
-}
-
-class ResourceLoader;
-class DynamicVertexBuffers;
-class VertexShader;
-class PixelShader;
-class MatrixBuffer;
-
 class FontEngine
 {
 public:
 
-	static FontEngine *CreateFontEngine(ResourceLoader *resources,
-		ID3D11Device *d3dDevice,
-		ID3D11DeviceContext *d3dDeviceContext);
+	// Fonts the device cannot load are left out, and text in them draws
+	// nothing
+	static FontEngine *CreateFontEngine(RenderDevice *renderDevice);
 	static void DestroyFontEngine(FontEngine *engine);
 
 	enum FontType
@@ -40,6 +31,10 @@ public:
 	void BeginFrame();
 	void EndFrame();
 
+	// Text is drawn a font at a time, at EndFrame() or when flushed, so it
+	// lands on top of everything ImmediateMode has drawn before it
+	void Flush();
+
 	int DrawText(const std::string &text,
 		int x,
 		int y,
@@ -58,41 +53,20 @@ private:
 
 	struct Font
 	{
-		DirectX::SpriteFont *sprite;
-		ID3D11ShaderResourceView *texture;
+		RenderFont *font;
+		std::vector<SpriteFontVertex> vertices;
 	};
 
 	typedef std::map<FontType, Font> FontTypeMap;
 
-	struct InitialisationParams
-	{
-		ID3D11DeviceContext *d3dDeviceContext;
-		FontTypeMap fonts;
-		DynamicVertexBuffers *vertexBuffers;
-		VertexShader *vertexShader;
-		PixelShader *pixelShader;
-		MatrixBuffer *modelViewProjection;
-		ID3D11SamplerState *textureSampler;
-	};
-
-	FontEngine(const InitialisationParams &initParams);
+	FontEngine(RenderDevice *renderDevice, const FontTypeMap &fonts);
 	~FontEngine();
 
-	static Font CreateFont(ID3D11Device *d3dDevice,
-		uint8_t *data,
-		uint32_t size);
-
-	ID3D11DeviceContext *d3dDeviceContext_;
-
-	DynamicVertexBuffers *vertexBuffers_;
-	VertexShader *vertexShader_;
-	PixelShader *pixelShader_;
-	MatrixBuffer *modelViewProjection_;
-	ID3D11SamplerState *textureSampler_;
+	RenderDevice *renderDevice_;
 
 	FontTypeMap fonts_;
 
-	XMFLOAT4X4 projectionMatrix_;
+	RenderMatrices matrices_;
 };
 
 #endif // FONTENGINE_H_INCLUDED
@@ -2,7 +2,7 @@
 #include "System.h"
 #include "Graphics.h"
 #include "FontEngine.h"
-#include "Game.h"
+#include "GameRenderer.h"
 
 GameOver::GameOver() :
 	delay_(0)
@@ -29,7 +29,7 @@ void GameOver::OnRender(System *system)
 	Graphics *graphics = system->GetGraphics();
 	FontEngine *fontEngine = graphics->GetFontEngine();
 
-	system->GetGame()->RenderBackgroundOnly(graphics);
+	system->GetGameRenderer()->RenderBackgroundOnly(graphics);
 
 	const char *gameOverText = "Game Over";
 	int textWidth = fontEngine->CalculateTextWidth(gameOverText, FontEngine::FONT_TYPE_LARGE);
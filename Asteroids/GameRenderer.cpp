@@ -0,0 +1,291 @@
+#include "GameRenderer.h"
+#include "OrthoCamera.h"
+#include "Background.h"
+#include "Graphics.h"
+#include "ImmediateMode.h"
+#include "ImmediateModeVertex.h"
+#include "FontEngine.h"
+#include "Game.h"
+#include "Ship.h"
+#include "UFO.h"
+#include <string>
+#include <vector>
+
+GameRenderer::GameRenderer() :
+	camera_(nullptr),
+	background_(nullptr)
+{
+	camera_ = new OrthoCamera();
+	camera_->SetPosition(XMFLOAT3(0.0f, 0.0f, 0.0f));
+	camera_->SetFrustum(800.0f, 600.0f, -100.0f, 100.0f);
+	background_ = new Background(800.0f, 600.0f);
+}
+
+GameRenderer::~GameRenderer()
+{
+	delete camera_;
+	delete background_;
+}
+
+void GameRenderer::RenderBackgroundOnly(Graphics *graphics) const
+{
+	camera_->SetAsView(graphics);
+	background_->Render(graphics);
+}
+
+void GameRenderer::RenderEverything(Graphics *graphics, const Game *game) const
+{
+	camera_->SetAsView(graphics);
+
+	background_->Render(graphics);
+
+	ImmediateMode *immediateGraphics = graphics->GetImmediateMode();
+	const SimClock &clock = game->GetClock();
+	float alpha = game->GetInterpolationAlpha();
+	//Velocities are per default-length tick, so step back by that many of them
+	float rewind = (1.0f - alpha) * clock.GetStepScale();
+
+	//A different exhaust pattern each tick makes it flicker
+	const PatternBank &patterns = game->GetPatternBank();
+	const XMFLOAT2 *exhaustPoints = patterns.GetExhaustPoints(
+		static_cast<unsigned int>(clock.GetTickCount() % patterns.GetNumPatterns()));
+
+	const Ship *player = game->GetPlayer();
+	if (player)
+	{
+		RenderShip(immediateGraphics, player, exhaustPoints, rewind);
+	}
+
+	const Ship *enemy = game->GetEnemy();
+	if (enemy)
+	{
+		const UFO *ufo = dynamic_cast<const UFO *>(enemy);
+		if (ufo)
+			RenderUFO(immediateGraphics, ufo);
+		else
+			RenderShip(immediateGraphics, enemy, exhaustPoints, rewind);
+	}
+
+	const World &world = game->GetWorld();
+
+	for (unsigned int index = 0; index < world.asteroids.Size(); ++index)
+	{
+		RenderAsteroid(immediateGraphics, world.asteroids, index, rewind);
+	}
+
+	for (unsigned int index = 0; index < world.bullets.Size(); ++index)
+	{
+		RenderBullet(immediateGraphics, world.bullets, index, rewind);
+	}
+
+	double renderTime = clock.GetTime() - (1.0 - alpha) * clock.GetTickSeconds();
+	RenderParticles(immediateGraphics, world.particles, renderTime);
+
+	FontEngine* fontEngine = graphics->GetFontEngine();
+
+	std::string scoreText = "Score: " + std::to_string(game->GetScore());
+
+	fontEngine->DrawText(scoreText, 0, 600 - 48, 0xffffff00);
+
+	// XMVectorGetX(XMConvertVectorFloatToUInt(popup.color, 0))
+	for (auto popup : game->GetPopups())
+		fontEngine->DrawText("+" + std::to_string(popup.value), popup.pos.x, popup.pos.y,0xff0000ff, FontEngine::FontType::FONT_TYPE_SMALL);
+
+	if (player)
+	{
+		scoreText = "Lives: " + std::to_string(player->GetNumLives());
+		fontEngine->DrawText(scoreText, 800 - 130, 600 - 48, 0xffffff00);
+	}
+}
+
+void GameRenderer::RenderShip(ImmediateMode *immediateGraphics, const Ship *ship,
+	const XMFLOAT2 *exhaustPoints, float rewind)
+{
+	ImmediateModeVertex axis[8] =
+	{
+		{0.0f, -5.0f, 0.0f, 0xffffffff}, {0.0f, 10.0f, 0.0f, 0xffffffff},
+		{-5.0f, 0.0f, 0.0f, 0xffffffff}, {5.0f, 0.0f, 0.0f, 0xffffffff},
+		{0.0f, 10.0f, 0.0f, 0xffffffff}, {-5.0f, 5.0f, 0.0f, 0xffffffff},
+		{0.0f, 10.0f, 0.0f, 0xffffffff}, {5.0f, 5.0f, 0.0f, 0xffffffff},
+	};
+
+	XMMATRIX rotationMatrix = XMMatrixRotationZ(ship->GetRotation());
+
+	XMVECTOR position = ship->GetPosition() - ship->GetVelocity() * rewind;
+	XMMATRIX translationMatrix = XMMatrixTranslation(
+		XMVectorGetX(position),
+		XMVectorGetY(position),
+		XMVectorGetZ(position));
+
+	XMMATRIX shipTransform = rotationMatrix * translationMatrix;
+
+	immediateGraphics->SetModelMatrix(shipTransform);
+	immediateGraphics->Draw(RENDER_TOPOLOGY_LINE_LIST,
+		&axis[0],
+		8);
+	immediateGraphics->SetModelMatrix(XMMatrixIdentity());
+
+	//If velocity not zero, draw exhaust particles
+	if (ship->IsThrusting())
+	{
+		const int numParticles = PatternBank::EXHAUST_POINTS;
+		ImmediateModeVertex exhaust[numParticles];
+
+		uint32_t baseColor(0xff3399FF); //Default color for exhaust 
+
+		//Points come from the pattern bank
+		for (int i = 0; i < numParticles; i++)
+		{
+			exhaust[i].x = exhaustPoints[i].x;
+			exhaust[i].y = exhaustPoints[i].y;
+			exhaust[i].z = 0.f;
+
+			exhaust[i].diffuse = baseColor * (((exhaust[i].y - (-30)) / 25));
+		}
+
+		immediateGraphics->SetModelMatrix(shipTransform);
+		immediateGraphics->Draw(RENDER_TOPOLOGY_POINT_LIST,
+			&exhaust[0],
+			numParticles);
+		immediateGraphics->SetModelMatrix(XMMatrixIdentity());
+	}
+}
+
+void GameRenderer::RenderUFO(ImmediateMode *immediateGraphics, const UFO *ufo)
+{
+	ImmediateModeVertex axis[14] =
+	{
+		{-5.0f, 0.0f, 0.0f, 0xffffffff}, {-5.0f, 5.0f, 0.0f, 0xffffffff},
+		{-5.0f, 5.0f, 0.0f, 0xffffffff}, {5.0f, 5.0f, 0.0f, 0xffffffff},
+		{5.0f, 5.0f, 0.0f, 0xffffffff}, {5.0f, 0.0f, 0.0f, 0xffffffff},
+		{5.0f, 0.0f, 0.0f, 0xffffffff}, {-5.0f, 0.0f, 0.0f, 0xffffffff},
+		{-5.0f, 0.0f, 0.0f, 0xffffffff}, {-10.0f, -5.0f, 0.0f, 0xffffffff},
+		{-10.0f, -5.0f, 0.0f, 0xffffffff}, {10.0f, -5.0f, 0.0f, 0xffffffff},
+		{10.0f, -5.0f, 0.0f, 0xffffffff}, {5.0f, 0.0f, 0.0f, 0xffffffff},
+	};
+
+	XMVECTOR position = ufo->GetPosition();
+	XMMATRIX translationMatrix = XMMatrixTranslation(
+		XMVectorGetX(position),
+		XMVectorGetY(position),
+		XMVectorGetZ(position));
+
+	XMMATRIX shipTransform = translationMatrix;
+
+	immediateGraphics->SetModelMatrix(shipTransform);
+	immediateGraphics->Draw(RENDER_TOPOLOGY_LINE_LIST,
+		&axis[0],
+		14);
+	immediateGraphics->SetModelMatrix(XMMatrixIdentity());
+}
+
+void GameRenderer::RenderAsteroid(ImmediateMode *immediateGraphics,
+	const World::AsteroidArrays &asteroids,
+	unsigned int index,
+	float rewind)
+{
+	const float RADIUS_MULTIPLIER = 5.0f;
+
+	ImmediateModeVertex square[5] =
+	{
+		{-1.0f, -1.0f, 0.0f, 0xffffffff},
+		{-1.0f,  1.0f, 0.0f, 0xffffffff},
+		{ 1.0f,  1.0f, 0.0f, 0xffffffff},
+		{ 1.0f, -1.0f, 0.0f, 0xffffffff},
+		{-1.0f, -1.0f, 0.0f, 0xffffffff},
+	};
+
+	int size = asteroids.size[index];
+	XMMATRIX scaleMatrix = XMMatrixScaling(
+		size * RADIUS_MULTIPLIER,
+		size * RADIUS_MULTIPLIER,
+		size * RADIUS_MULTIPLIER);
+
+	XMMATRIX rotationMatrix = XMMatrixRotationAxis(
+		XMLoadFloat3(&asteroids.axis[index]),
+		asteroids.angle[index]);
+
+	XMMATRIX translationMatrix = XMMatrixTranslation(
+		asteroids.positionX[index] - asteroids.velocityX[index] * rewind,
+		asteroids.positionY[index] - asteroids.velocityY[index] * rewind,
+		0.0f);
+
+	XMMATRIX asteroidTransform = scaleMatrix *
+		rotationMatrix *
+		translationMatrix;
+
+	immediateGraphics->SetModelMatrix(asteroidTransform);
+	immediateGraphics->Draw(RENDER_TOPOLOGY_LINE_STRIP,
+		&square[0],
+		5);
+	immediateGraphics->SetModelMatrix(XMMatrixIdentity());
+}
+
+void GameRenderer::RenderBullet(ImmediateMode *immediateGraphics,
+	const World::BulletArrays &bullets,
+	unsigned int index,
+	float rewind)
+{
+	const float RADIUS = 3.0f;
+
+	int numLines = 4;
+	ImmediateModeVertex square[5] =
+	{
+		{-RADIUS, -RADIUS, 0.0f, 0xffffffff},
+		{-RADIUS,  RADIUS, 0.0f, 0xffffffff},
+		{ RADIUS,  RADIUS, 0.0f, 0xffffffff},
+		{ RADIUS, -RADIUS, 0.0f, 0xffffffff},
+		{-RADIUS, -RADIUS, 0.0f, 0xffffffff},
+	};
+
+	if (bullets.owner[index] == Enemy)
+	{
+		numLines = 3;
+		square[2].y = 0.f;
+		square[3] = square[4];
+	}
+
+	XMMATRIX translationMatrix = XMMatrixTranslation(
+		bullets.positionX[index] - bullets.velocityX[index] * rewind,
+		bullets.positionY[index] - bullets.velocityY[index] * rewind,
+		0.0f);
+
+	immediateGraphics->SetModelMatrix(translationMatrix);
+	immediateGraphics->Draw(RENDER_TOPOLOGY_LINE_STRIP,
+		&square[0],
+		numLines == 4 ? 5 : 4);
+	immediateGraphics->SetModelMatrix(XMMatrixIdentity());
+}
+
+void GameRenderer::RenderParticles(ImmediateMode *immediateGraphics,
+	const ParticleSystem &particles,
+	double time) const
+{
+	unsigned int maxAnalytic = particles.GetMaxAnalyticParticles();
+	if (maxAnalytic == 0)
+		return;
+
+	//Particles only exist once worked out here
+	analyticX_.resize(maxAnalytic);
+	analyticY_.resize(maxAnalytic);
+	unsigned int numParticles = particles.EvaluateAnalytic(time, analyticX_.data(), analyticY_.data(), maxAnalytic);
+	if (numParticles == 0)
+		return;
+
+	particlePoints_.resize(numParticles);
+	uint32_t baseColor(0xFFF54C0F);
+
+	//All in one draw
+	for (unsigned int index = 0; index < numParticles; ++index)
+	{
+		ImmediateModeVertex &point = particlePoints_[index];
+		point.x = analyticX_[index];
+		point.y = analyticY_[index];
+		point.z = 0;
+		point.diffuse = baseColor;
+	}
+
+	immediateGraphics->Draw(RENDER_TOPOLOGY_POINT_LIST,
+		particlePoints_.data(),
+		numParticles);
+}
@@ -0,0 +1,61 @@
+#ifndef GAMERENDERER_H_INCLUDED
+#define GAMERENDERER_H_INCLUDED
+
+#include <DirectXMath.h>
+#include <vector>
+#include "World.h"
+#include "ImmediateModeVertex.h"
+
+using namespace DirectX;
+
+class OrthoCamera;
+class Background;
+class Graphics;
+class ImmediateMode;
+class Game;
+class Ship;
+class UFO;
+
+// Draws the state of a Game. The simulation itself knows nothing about
+// Graphics, so everything visual about the entities lives here. Moving things
+// are drawn between their last two ticks using the clock's interpolation alpha,
+// stepping back along their velocities.
+class GameRenderer
+{
+public:
+	GameRenderer();
+	~GameRenderer();
+
+	void RenderBackgroundOnly(Graphics *graphics) const;
+	void RenderEverything(Graphics *graphics, const Game *game) const;
+
+private:
+	GameRenderer(const GameRenderer &);
+	void operator=(const GameRenderer &);
+
+	static void RenderShip(ImmediateMode *immediateGraphics, const Ship *ship,
+		const XMFLOAT2 *exhaustPoints, float rewind);
+	static void RenderUFO(ImmediateMode *immediateGraphics, const UFO *ufo);
+	static void RenderAsteroid(ImmediateMode *immediateGraphics,
+		const World::AsteroidArrays &asteroids,
+		unsigned int index,
+		float rewind);
+	static void RenderBullet(ImmediateMode *immediateGraphics,
+		const World::BulletArrays &bullets,
+		unsigned int index,
+		float rewind);
+	void RenderParticles(ImmediateMode *immediateGraphics,
+		const ParticleSystem &particles,
+		double time) const;
+
+	OrthoCamera *camera_;
+	Background *background_;
+
+	// Scratch for RenderParticles, kept between frames so it stops allocating
+	// once it has grown to the busiest frame
+	mutable std::vector<float> analyticX_;
+	mutable std::vector<float> analyticY_;
+	mutable std::vector<ImmediateModeVertex> particlePoints_;
+};
+
+#endif // GAMERENDERER_H_INCLUDED
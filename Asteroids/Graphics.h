@@ -1,20 +1,20 @@
 #ifndef GRAPHICS_H_INCLUDED
 #define GRAPHICS_H_INCLUDED
 
-#include "AssetManager.h"
-#include <d3d11.h>
 #include <DirectXMath.h>
 
 using namespace DirectX;
 
-class ResourceLoader;
+class RenderDevice;
 class ImmediateMode;
 class FontEngine;
 
 class Graphics
 {
 public:
-	static Graphics *CreateDevice(HWND window, ResourceLoader *binaryResources);
+	// Renders through renderDevice, which stays the caller's and must
+	// outlive the Graphics
+	static Graphics *CreateDevice(RenderDevice *renderDevice);
 	static void DestroyDevice(Graphics *device);
 
 	void BeginFrame();
@@ -24,38 +24,23 @@ public:
 
 	ImmediateMode *GetImmediateMode() const;
 	FontEngine *GetFontEngine() const;
+	RenderDevice *GetRenderDevice() const;
 
 private:
 
-	struct InitialisationParams
-	{
-		IDXGISwapChain * dxgiSwapChain;
-		ID3D11Device *d3dDevice;
-		ID3D11DeviceContext *d3dDeviceContext;
-		ID3D11RenderTargetView *d3dRenderTargetView;
-	};
-
-	Graphics(const InitialisationParams &initParams);
+	Graphics(RenderDevice *renderDevice);
 	~Graphics();
 
 	Graphics(const Graphics &);
 	void operator=(const Graphics &);
 
-	bool CreateResources(ResourceLoader *binaryResources);
-	bool CreateSpriteFontResources(ResourceLoader *binaryResources);
+	bool CreateResources();
 	void DestroyResources();
-	void DestroySpriteFontResources();
-
-	IDXGISwapChain *dxgiSwapChain_;
-
-	ID3D11Device *d3dDevice_;
-	ID3D11DeviceContext *d3dDeviceContext_;
-	ID3D11RenderTargetView *d3dRenderTargetView_;
 
-	D3D11_VIEWPORT defaultViewport_;
+	RenderDevice *renderDevice_;
 
 	ImmediateMode *immediateMode_;
 	FontEngine *fontEngine_;
 };
 
-#endif GRAPHICS_H_INCLUDED
+#endif // GRAPHICS_H_INCLUDED
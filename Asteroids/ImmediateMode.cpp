@@ -1,84 +1,28 @@
 #include "ImmediateMode.h"
-#include "DynamicVertexBuffers.h"
-#include "VertexShader.h"
-#include "PixelShader.h"
-#include "MatrixBuffer.h"
-#include "ResourceLoader.h"
-#include "resource.h"
-
-ImmediateMode::ImmediateMode(ID3D11DeviceContext *d3dDeviceContext,
-	DynamicVertexBuffers *vertexBuffers,
-	VertexShader *vertexShader,
-	PixelShader *pixelShader,
-	MatrixBuffer *modelViewProjection) :
-	d3dDeviceContext_(d3dDeviceContext),
-	vertexBuffers_(vertexBuffers),
-	vertexShader_(vertexShader),
-	pixelShader_(pixelShader),
-	modelViewProjection_(modelViewProjection)
+#include <cstring>
+
+ImmediateMode::ImmediateMode(RenderDevice *renderDevice) :
+	renderDevice_(renderDevice),
+	modelIsIdentity_(true)
 {
-	XMStoreFloat4x4(&modelMatrix_, XMMatrixIdentity());
-	XMStoreFloat4x4(&viewMatrix_, XMMatrixIdentity());
-	XMStoreFloat4x4(&projectionMatrix_, XMMatrixIdentity());
+	XMStoreFloat4x4(&matrices_.model, XMMatrixIdentity());
+	XMStoreFloat4x4(&matrices_.view, XMMatrixIdentity());
+	XMStoreFloat4x4(&matrices_.projection, XMMatrixIdentity());
 }
 
 ImmediateMode::~ImmediateMode()
 {
 }
 
-ImmediateMode *ImmediateMode::CreateImmediateMode(ResourceLoader *resources,
-	ID3D11Device *d3dDevice,
-	ID3D11DeviceContext *d3dDeviceContext)
+ImmediateMode *ImmediateMode::CreateImmediateMode(RenderDevice *renderDevice)
 {
-	const unsigned int MAX_IMMEDIATE_MODE_VERTICES = 1 * 1024 * 1024;
-
-	ResourceLoader::Resource vertexShaderResource;
-	resources->LoadResource(IDR_VERTEX_SHADER_FVF_XYZ_DIFFUSE, &vertexShaderResource);
-
-	ResourceLoader::Resource pixelShaderResource;
-	resources->LoadResource(IDR_PIXEL_SHADER_FVF_XYZ_DIFFUSE, &pixelShaderResource);
-
-	DynamicVertexBuffers *vertexBuffers = DynamicVertexBuffers::CreateDynamicVertexBuffers<ImmediateModeVertex>(
-		MAX_IMMEDIATE_MODE_VERTICES,
-		2,
-		d3dDevice);
-	MatrixBuffer *modelViewProjection = MatrixBuffer::CreateMatrixBuffer(d3dDevice);
-
-	std::vector<D3D11_INPUT_ELEMENT_DESC> vertexLayout;
-	vertexLayout.resize(2);
-
-	vertexLayout[0].SemanticName = "POSITION";
-	vertexLayout[0].SemanticIndex = 0;
-	vertexLayout[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	vertexLayout[0].InputSlot = 0;
-	vertexLayout[0].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	vertexLayout[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	vertexLayout[0].InstanceDataStepRate = 0;
-
-	vertexLayout[1].SemanticName = "COLOR";
-	vertexLayout[1].SemanticIndex = 0;
-	vertexLayout[1].Format = DXGI_FORMAT_R8G8B8A8_UINT;
-	vertexLayout[1].InputSlot = 0;
-	vertexLayout[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	vertexLayout[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	vertexLayout[1].InstanceDataStepRate = 0;
-
-	VertexShader *vertexShader = VertexShader::CreateVertexShader(
-		vertexShaderResource.data,
-		vertexShaderResource.size,
-		d3dDevice,
-		vertexLayout);
-
-	PixelShader *pixelShader = PixelShader::CreatePixelShader(
-		pixelShaderResource.data,
-		pixelShaderResource.size,
-		d3dDevice);
-
-	return new ImmediateMode(d3dDeviceContext,
-		vertexBuffers,
-		vertexShader,
-		pixelShader,
-		modelViewProjection);
+	const unsigned int INITIAL_BATCH_VERTICES = 16 * 1024;
+
+	ImmediateMode *mode = new ImmediateMode(renderDevice);
+	mode->batches_[RENDER_TOPOLOGY_POINT_LIST].reserve(INITIAL_BATCH_VERTICES);
+	mode->batches_[RENDER_TOPOLOGY_LINE_LIST].reserve(INITIAL_BATCH_VERTICES);
+	mode->batches_[RENDER_TOPOLOGY_TRIANGLE_LIST].reserve(INITIAL_BATCH_VERTICES);
+	return mode;
 }
 
 void ImmediateMode::DestroyImmediateMode(ImmediateMode *mode)
@@ -86,64 +30,147 @@ void ImmediateMode::DestroyImmediateMode(ImmediateMode *mode)
 	if (mode == 0)
 		return;
 
-	DynamicVertexBuffers::DestroyDynamicVertexBuffers(mode->vertexBuffers_);
-	VertexShader::DestroyVertexShader(mode->vertexShader_);
-	PixelShader::DestroyPixelShader(mode->pixelShader_);
-	MatrixBuffer::DestroyMatrixBuffer(mode->modelViewProjection_);
-
 	delete mode;
 }
 
 void ImmediateMode::BeginFrame()
 {
-	vertexBuffers_->BeginFrame();
 }
 
 void ImmediateMode::EndFrame()
 {
-	vertexBuffers_->EndFrame();
+	Flush();
 }
 
 void ImmediateMode::SetModelMatrix(XMMATRIX modelMatrix)
 {
-	XMStoreFloat4x4(&modelMatrix_, modelMatrix);
+	XMStoreFloat4x4(&matrices_.model, modelMatrix);
+	modelIsIdentity_ = XMMatrixIsIdentity(modelMatrix);
 }
 
 void ImmediateMode::SetViewMatrix(XMMATRIX viewMatrix)
 {
-	XMStoreFloat4x4(&viewMatrix_, viewMatrix);
+	SetBatchMatrix(&matrices_.view, viewMatrix);
 }
 
 void ImmediateMode::SetProjectionMatrix(XMMATRIX projectionMatrix)
 {
-	XMStoreFloat4x4(&projectionMatrix_, projectionMatrix);
+	SetBatchMatrix(&matrices_.projection, projectionMatrix);
 }
 
-void ImmediateMode::Draw(D3D11_PRIMITIVE_TOPOLOGY primType,
+void ImmediateMode::Draw(RenderTopology primType,
 	const ImmediateModeVertex *vertices,
 	unsigned int vertexCount)
 {
-	// Copy dynamic vertex data
-	DynamicVertexBuffers::VertexRange copiedRange;
-	bool copiedVerts = vertexBuffers_->CopyVertexData(vertices, vertexCount, d3dDeviceContext_, &copiedRange);
-	if (copiedVerts == false)
+	switch (primType)
 	{
-		return;
+	case RENDER_TOPOLOGY_LINE_STRIP:
+	{
+		if (vertexCount < 2)
+			return;
+
+		stripVertices_.resize(vertexCount);
+		TransformVertices(vertices, vertexCount, &stripVertices_[0]);
+
+		// Each segment of the strip as a line of its own
+		VertexVector &batch = batches_[RENDER_TOPOLOGY_LINE_LIST];
+		for (unsigned int i = 1; i < vertexCount; i++)
+		{
+			batch.push_back(stripVertices_[i - 1]);
+			batch.push_back(stripVertices_[i]);
+		}
+		break;
 	}
 
-	// Set up our shaders
-	vertexShader_->VSSetShader(d3dDeviceContext_);
-	pixelShader_->PSSetShader(d3dDeviceContext_);
+	case RENDER_TOPOLOGY_TRIANGLE_STRIP:
+	{
+		if (vertexCount < 3)
+			return;
+
+		stripVertices_.resize(vertexCount);
+		TransformVertices(vertices, vertexCount, &stripVertices_[0]);
+
+		// Every other triangle of a strip is wound the other way round
+		VertexVector &batch = batches_[RENDER_TOPOLOGY_TRIANGLE_LIST];
+		for (unsigned int i = 2; i < vertexCount; i++)
+		{
+			bool odd = (i & 1) != 0;
+			batch.push_back(stripVertices_[odd ? i - 1 : i - 2]);
+			batch.push_back(stripVertices_[odd ? i - 2 : i - 1]);
+			batch.push_back(stripVertices_[i]);
+		}
+		break;
+	}
 
-	// Flush constant buffers
-	modelViewProjection_->VSSetConstantBuffers(d3dDeviceContext_,
-		XMLoadFloat4x4(&modelMatrix_),
-		XMLoadFloat4x4(&viewMatrix_),
-		XMLoadFloat4x4(&projectionMatrix_));
+	default:
+	{
+		if (vertexCount == 0)
+			return;
+
+		VertexVector &batch = batches_[primType];
+		size_t first = batch.size();
+		batch.resize(first + vertexCount);
+		TransformVertices(vertices, vertexCount, &batch[first]);
+		break;
+	}
+	}
+}
 
-	// Issue draw command
-	d3dDeviceContext_->IASetPrimitiveTopology(primType);
-	vertexBuffers_->IASetVertexBuffer(d3dDeviceContext_);
-	d3dDeviceContext_->Draw(vertexCount, copiedRange.begin);
+void ImmediateMode::Flush()
+{
+	// Batched vertices are already in world space
+	RenderMatrices batchMatrices = matrices_;
+	XMStoreFloat4x4(&batchMatrices.model, XMMatrixIdentity());
+
+	for (int topology = 0; topology < RENDER_TOPOLOGY_COUNT; ++topology)
+	{
+		VertexVector &batch = batches_[topology];
+		if (batch.empty())
+			continue;
+
+		renderDevice_->Draw(RENDER_PIPELINE_IMMEDIATE_MODE,
+			static_cast<RenderTopology>(topology),
+			batchMatrices,
+			0,
+			&batch[0],
+			static_cast<unsigned int>(batch.size()));
+
+		// Keeps the capacity for the next frame
+		batch.clear();
+	}
 }
 
+void ImmediateMode::TransformVertices(const ImmediateModeVertex *vertices,
+	unsigned int vertexCount,
+	ImmediateModeVertex *transformed) const
+{
+	if (modelIsIdentity_)
+	{
+		memcpy(transformed, vertices, vertexCount * sizeof(ImmediateModeVertex));
+		return;
+	}
+
+	XMMATRIX model = XMLoadFloat4x4(&matrices_.model);
+	for (unsigned int i = 0; i < vertexCount; i++)
+	{
+		XMVECTOR position = XMVectorSet(vertices[i].x, vertices[i].y, vertices[i].z, 1.0f);
+		position = XMVector3Transform(position, model);
+
+		transformed[i].x = XMVectorGetX(position);
+		transformed[i].y = XMVectorGetY(position);
+		transformed[i].z = XMVectorGetZ(position);
+		transformed[i].diffuse = vertices[i].diffuse;
+	}
+}
+
+void ImmediateMode::SetBatchMatrix(XMFLOAT4X4 *matrix, XMMATRIX newMatrix)
+{
+	XMFLOAT4X4 stored;
+	XMStoreFloat4x4(&stored, newMatrix);
+	if (memcmp(&stored, matrix, sizeof(stored)) == 0)
+		return;
+
+	// What is batched so far was meant for the old matrix
+	Flush();
+	*matrix = stored;
+}
@@ -1,25 +1,24 @@
 #ifndef IMMEDIATEMODE_H_INCLUDED
 #define IMMEDIATEMODE_H_INCLUDED
 
-#include <d3d11.h>
+#include "RenderDevice.h"
+#include "ImmediateModeVertex.h"
 #include <DirectXMath.h>
+#include <vector>
 
 using namespace DirectX;
 
-class ResourceLoader;
-class DynamicVertexBuffers;
-class VertexShader;
-class PixelShader;
-class MatrixBuffer;
-struct ImmediateModeVertex;
-
+// Draws are not sent to the device as they come. Each one's vertices are
+// moved into world space by the current model matrix on the CPU and added
+// to a batch for its topology, with strips turned into lists so they can
+// share one. The batches go to the device as one draw per topology at
+// EndFrame(), or sooner if the view or projection changes. Model matrices
+// are taken to be affine, as every one in the game is.
 class ImmediateMode
 {
 public:
 
-	static ImmediateMode *CreateImmediateMode(ResourceLoader *resources,
-		ID3D11Device *d3dDevice,
-		ID3D11DeviceContext *d3dDeviceContext);
+	static ImmediateMode *CreateImmediateMode(RenderDevice *renderDevice);
 	static void DestroyImmediateMode(ImmediateMode *mode);
 
 	void BeginFrame();
@@ -29,29 +28,35 @@ public:
 	void SetViewMatrix(XMMATRIX viewMatrix);
 	void SetProjectionMatrix(XMMATRIX projectionMatrix);
 
-	void Draw(D3D11_PRIMITIVE_TOPOLOGY primType,
+	void Draw(RenderTopology primType,
 		const ImmediateModeVertex *vertices,
 		unsigned int vertexCount);
 
+	// Sends the batches now
+	void Flush();
+
 private:
+	typedef std::vector<ImmediateModeVertex> VertexVector;
 
-	ImmediateMode(ID3D11DeviceContext *d3dDeviceContext,
-		DynamicVertexBuffers *vertexBuffers,
-		VertexShader *vertexShader,
-		PixelShader *pixelShader,
-		MatrixBuffer *modelViewProjection);
+	ImmediateMode(RenderDevice *renderDevice);
 	~ImmediateMode();
 
-	ID3D11DeviceContext *d3dDeviceContext_;
+	ImmediateMode(const ImmediateMode &);
+	void operator=(const ImmediateMode &);
+
+	void TransformVertices(const ImmediateModeVertex *vertices,
+		unsigned int vertexCount,
+		ImmediateModeVertex *transformed) const;
+	void SetBatchMatrix(XMFLOAT4X4 *matrix, XMMATRIX newMatrix);
+
+	RenderDevice *renderDevice_;
 
-	DynamicVertexBuffers *vertexBuffers_;
-	VertexShader *vertexShader_;
-	PixelShader *pixelShader_;
-	MatrixBuffer *modelViewProjection_;
+	RenderMatrices matrices_;
+	bool modelIsIdentity_;
 
-	XMFLOAT4X4 modelMatrix_;
-	XMFLOAT4X4 viewMatrix_;
-	XMFLOAT4X4 projectionMatrix_;
+	// By the topology they are drawn with: points, lines and triangles
+	VertexVector batches_[RENDER_TOPOLOGY_COUNT];
+	VertexVector stripVertices_;
 };
 
 #endif // IMMEDIATEMODER_H_INCLUDED
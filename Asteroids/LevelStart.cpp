@@ -2,7 +2,7 @@
 #include "System.h"
 #include "Graphics.h"
 #include "FontEngine.h"
-#include "Game.h"
+#include "GameRenderer.h"
 
 LevelStart::LevelStart() :
 	level_(0),
@@ -31,7 +31,7 @@ void LevelStart::OnRender(System *system)
 	Graphics *graphics = system->GetGraphics();
 	FontEngine *fontEngine = graphics->GetFontEngine();
 
-	system->GetGame()->RenderBackgroundOnly(graphics);
+	system->GetGameRenderer()->RenderBackgroundOnly(graphics);
 
 	char levelStartText[256];
 	sprintf_s(levelStartText, "Level %d", level_);
@@ -1,7 +1,7 @@
 #include "MainMenu.h"
 #include "System.h"
 #include "Graphics.h"
-#include "Game.h"
+#include "GameRenderer.h"
 #include "FontEngine.h"
 #include "Keyboard.h"
 
@@ -33,7 +33,7 @@ void MainMenu::OnRender(System *system)
 	Graphics *graphics = system->GetGraphics();
 	FontEngine *fontEngine = graphics->GetFontEngine();
 
-	system->GetGame()->RenderBackgroundOnly(graphics);
+	system->GetGameRenderer()->RenderBackgroundOnly(graphics);
 
 	fontEngine->DrawText("ASTEROIDS", 50, 50, 0xff00ffff, FontEngine::FONT_TYPE_LARGE);
 	fontEngine->DrawText("Press [Space] to Start", 50, 100, 0xffffffff, FontEngine::FONT_TYPE_SMALL);
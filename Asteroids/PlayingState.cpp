@@ -1,6 +1,8 @@
 #include "PlayingState.h"
 #include "System.h"
 #include "Game.h"
+#include "GameRenderer.h"
+#include "Keyboard.h"
 
 PlayingState::PlayingState()
 {
@@ -16,12 +18,18 @@ void PlayingState::OnActivate(System *system, StateArgumentMap &args)
 
 	level_ = args["Level"].asInt;
 	game->InitialiseLevel(level_);
+	lastUpdateTime_ = std::chrono::steady_clock::now();
 }
 
 void PlayingState::OnUpdate(System *system)
 {
 	Game *game = system->GetGame();
-	game->Update(system);
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::chrono::duration<double> elapsed = now - lastUpdateTime_;
+	lastUpdateTime_ = now;
+
+	game->Advance(elapsed.count(), ReadInput(system));
 
 	GameState::StateArgument arg;
 	arg.asInt = game->GetScore();
@@ -45,9 +53,52 @@ void PlayingState::OnUpdate(System *system)
 void PlayingState::OnRender(System *system)
 {
 	Game *game = system->GetGame();
-	game->RenderEverything(system->GetGraphics());
+	system->GetGameRenderer()->RenderEverything(system->GetGraphics(), game);
 }
 
 void PlayingState::OnDeactivate(System *system)
 {
 }
+
+GameInput PlayingState::ReadInput(System *system)
+{
+	GameInput input;
+	Keyboard* keyboard = system->GetKeyboard();
+
+	if (keyboard->IsKeyHeld(VK_UP) || keyboard->IsKeyHeld('W'))
+	{
+		input.acceleration = 1.0f;
+	}
+	else if (keyboard->IsKeyHeld(VK_DOWN) || keyboard->IsKeyHeld('S'))
+	{
+		input.acceleration = -1.0f;
+	}
+
+	if (keyboard->IsKeyHeld(VK_RIGHT) || keyboard->IsKeyHeld('D'))
+	{
+		input.rotation = -1.0f;
+	}
+	else if (keyboard->IsKeyHeld(VK_LEFT) || keyboard->IsKeyHeld('A'))
+	{
+		input.rotation = 1.0f;
+	}
+
+	if (keyboard->IsKeyPressed(0x31)) //1
+	{
+		input.fireMode = GameInput::FIRE_MODE_SINGLE;
+	}
+	else if (keyboard->IsKeyPressed(0x32)) //2
+	{
+		input.fireMode = GameInput::FIRE_MODE_SINGLE_FAST;
+	}
+	else if (keyboard->IsKeyPressed(0x33)) //3
+	{
+		input.fireMode = GameInput::FIRE_MODE_SCATTER;
+	}
+
+	DirectX::Mouse::State mouseState = system->GetMouse()->GetState();
+
+	input.fire = keyboard->IsKeyHeld(VK_SPACE) || mouseState.leftButton;
+
+	return input;
+}
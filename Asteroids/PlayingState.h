@@ -2,6 +2,8 @@
 #define PLAYINGSTATE_H_INCLUDED
 
 #include "GameState.h"
+#include "GameInput.h"
+#include <chrono>
 
 class PlayingState : public GameState
 {
@@ -16,7 +18,10 @@ public:
 
 private:
 
+	static GameInput ReadInput(System *system);
+
 	int level_;
+	std::chrono::steady_clock::time_point lastUpdateTime_;
 
 };
 
@@ -0,0 +1,167 @@
+#include "RecordingRenderDevice.h"
+#include <cstring>
+
+namespace
+{
+	class RecordingRenderFont : public RenderFont
+	{
+	public:
+		virtual void BuildText(const char *text,
+			float x,
+			float y,
+			uint32_t colour,
+			std::vector<SpriteFontVertex> *vertices) const
+		{
+			const float width = static_cast<float>(RecordingRenderDevice::GLYPH_WIDTH);
+			const float height = static_cast<float>(RecordingRenderDevice::LINE_SPACING);
+			for (const char *character = text; *character != '\0'; ++character, x += width)
+			{
+				if (*character == ' ')
+					continue;
+
+				// Same winding as SpriteFontRenderer
+				const float cornerX[6] = { x, x + width, x, x + width, x, x + width };
+				const float cornerY[6] = { y, y, y + height, y + height, y + height, y };
+				for (int corner = 0; corner < 6; ++corner)
+				{
+					SpriteFontVertex vertex;
+					vertex.x = cornerX[corner];
+					vertex.y = cornerY[corner];
+					vertex.u = 0.0f;
+					vertex.v = 0.0f;
+					vertex.diffuse = colour;
+					vertices->push_back(vertex);
+				}
+			}
+		}
+
+		virtual float GetLineSpacing() const
+		{
+			return static_cast<float>(RecordingRenderDevice::LINE_SPACING);
+		}
+
+		virtual float MeasureWidth(const char *text) const
+		{
+			return static_cast<float>(strlen(text) * RecordingRenderDevice::GLYPH_WIDTH);
+		}
+
+		virtual RenderTexture GetTexture() const
+		{
+			return 0;
+		}
+	};
+}
+
+RecordingRenderDevice::RecordingRenderDevice(bool captureVertices) :
+	captureVertices_(captureVertices),
+	clearCount_(0),
+	frameCount_(0),
+	totalDrawCalls_(0),
+	totalVertices_(0)
+{
+	for (int pipeline = 0; pipeline < RENDER_PIPELINE_COUNT; ++pipeline)
+	{
+		vertexCounts_[pipeline] = 0;
+	}
+}
+
+RecordingRenderDevice::~RecordingRenderDevice()
+{
+}
+
+void RecordingRenderDevice::BeginFrame()
+{
+	// Clearing keeps the capacity, so steady frames record without allocating
+	drawCalls_.clear();
+	for (int pipeline = 0; pipeline < RENDER_PIPELINE_COUNT; ++pipeline)
+	{
+		vertexStreams_[pipeline].clear();
+		vertexCounts_[pipeline] = 0;
+	}
+	clearCount_ = 0;
+}
+
+void RecordingRenderDevice::EndFrame()
+{
+	++frameCount_;
+}
+
+void RecordingRenderDevice::ClearFrame(float /*r*/, float /*g*/, float /*b*/, float /*a*/)
+{
+	++clearCount_;
+}
+
+bool RecordingRenderDevice::Draw(RenderPipeline pipeline,
+	RenderTopology topology,
+	const RenderMatrices &matrices,
+	RenderTexture texture,
+	const void *vertices,
+	unsigned int vertexCount)
+{
+	DrawCall drawCall;
+	drawCall.pipeline = pipeline;
+	drawCall.topology = topology;
+	drawCall.matrices = matrices;
+	drawCall.texture = texture;
+	drawCall.firstVertex = vertexCounts_[pipeline];
+	drawCall.vertexCount = vertexCount;
+	drawCalls_.push_back(drawCall);
+
+	if (captureVertices_)
+	{
+		const uint8_t *bytes = static_cast<const uint8_t *>(vertices);
+		vertexStreams_[pipeline].insert(vertexStreams_[pipeline].end(),
+			bytes,
+			bytes + vertexCount * GetVertexSize(pipeline));
+	}
+
+	vertexCounts_[pipeline] += vertexCount;
+	++totalDrawCalls_;
+	totalVertices_ += vertexCount;
+	return true;
+}
+
+RenderFont *RecordingRenderDevice::LoadFont(int /*resourceId*/)
+{
+	return new RecordingRenderFont();
+}
+
+void RecordingRenderDevice::DestroyFont(RenderFont *font)
+{
+	delete font;
+}
+
+const std::vector<RecordingRenderDevice::DrawCall> &RecordingRenderDevice::GetDrawCalls() const
+{
+	return drawCalls_;
+}
+
+const uint8_t *RecordingRenderDevice::GetVertexStream(RenderPipeline pipeline) const
+{
+	return vertexStreams_[pipeline].data();
+}
+
+unsigned int RecordingRenderDevice::GetVertexCount(RenderPipeline pipeline) const
+{
+	return vertexCounts_[pipeline];
+}
+
+unsigned int RecordingRenderDevice::GetClearCount() const
+{
+	return clearCount_;
+}
+
+unsigned int RecordingRenderDevice::GetFrameCount() const
+{
+	return frameCount_;
+}
+
+uint64_t RecordingRenderDevice::GetTotalDrawCalls() const
+{
+	return totalDrawCalls_;
+}
+
+uint64_t RecordingRenderDevice::GetTotalVertices() const
+{
+	return totalVertices_;
+}
@@ -0,0 +1,77 @@
+#ifndef RECORDINGRENDERDEVICE_H_INCLUDED
+#define RECORDINGRENDERDEVICE_H_INCLUDED
+
+#include "RenderDevice.h"
+#include <stdint.h>
+#include <vector>
+
+// A render device with no GPU behind it. Each frame's draws, with their
+// topology, matrices and vertices, are kept in memory until the next
+// BeginFrame(), so frame building can be run, timed and checked on any
+// platform. With captureVertices off only the draw calls are kept, which
+// makes it next to free for timing the code above it. Every font is a
+// fixed-width stand-in with no texture: each character other than a space
+// is one quad GLYPH_WIDTH wide, and lines are LINE_SPACING apart.
+class RecordingRenderDevice : public RenderDevice
+{
+public:
+	static const int GLYPH_WIDTH = 8;
+	static const int LINE_SPACING = 16;
+
+	struct DrawCall
+	{
+		RenderPipeline pipeline;
+		RenderTopology topology;
+		RenderMatrices matrices;
+		RenderTexture texture;
+		// Into the pipeline's vertex stream for the frame
+		unsigned int firstVertex;
+		unsigned int vertexCount;
+	};
+
+	explicit RecordingRenderDevice(bool captureVertices = true);
+	virtual ~RecordingRenderDevice();
+
+	virtual void BeginFrame();
+	virtual void EndFrame();
+
+	virtual void ClearFrame(float r, float g, float b, float a);
+
+	virtual bool Draw(RenderPipeline pipeline,
+		RenderTopology topology,
+		const RenderMatrices &matrices,
+		RenderTexture texture,
+		const void *vertices,
+		unsigned int vertexCount);
+
+	virtual RenderFont *LoadFont(int resourceId);
+	virtual void DestroyFont(RenderFont *font);
+
+	// This frame's recording
+	const std::vector<DrawCall> &GetDrawCalls() const;
+	const uint8_t *GetVertexStream(RenderPipeline pipeline) const;
+	unsigned int GetVertexCount(RenderPipeline pipeline) const;
+	unsigned int GetClearCount() const;
+
+	// Over every frame so far
+	unsigned int GetFrameCount() const;
+	uint64_t GetTotalDrawCalls() const;
+	uint64_t GetTotalVertices() const;
+
+private:
+	RecordingRenderDevice(const RecordingRenderDevice &);
+	void operator=(const RecordingRenderDevice &);
+
+	bool captureVertices_;
+
+	std::vector<DrawCall> drawCalls_;
+	std::vector<uint8_t> vertexStreams_[RENDER_PIPELINE_COUNT];
+	unsigned int vertexCounts_[RENDER_PIPELINE_COUNT];
+	unsigned int clearCount_;
+
+	unsigned int frameCount_;
+	uint64_t totalDrawCalls_;
+	uint64_t totalVertices_;
+};
+
+#endif // RECORDINGRENDERDEVICE_H_INCLUDED
@@ -0,0 +1,16 @@
+#include "RenderDevice.h"
+#include "ImmediateModeVertex.h"
+#include "SpriteFontVertex.h"
+
+unsigned int RenderDevice::GetVertexSize(RenderPipeline pipeline)
+{
+	switch (pipeline)
+	{
+	case RENDER_PIPELINE_IMMEDIATE_MODE:
+		return sizeof(ImmediateModeVertex);
+	case RENDER_PIPELINE_SPRITE_FONT:
+		return sizeof(SpriteFontVertex);
+	default:
+		return 0;
+	}
+}
@@ -0,0 +1,91 @@
+#ifndef RENDERDEVICE_H_INCLUDED
+#define RENDERDEVICE_H_INCLUDED
+
+#include "SpriteFontVertex.h"
+#include <DirectXMath.h>
+#include <stddef.h>
+#include <vector>
+
+using namespace DirectX;
+
+enum RenderTopology
+{
+	RENDER_TOPOLOGY_POINT_LIST,
+	RENDER_TOPOLOGY_LINE_LIST,
+	RENDER_TOPOLOGY_LINE_STRIP,
+	RENDER_TOPOLOGY_TRIANGLE_LIST,
+	RENDER_TOPOLOGY_TRIANGLE_STRIP,
+
+	RENDER_TOPOLOGY_COUNT
+};
+
+// The shaders and vertex layout a draw goes through
+enum RenderPipeline
+{
+	RENDER_PIPELINE_IMMEDIATE_MODE,	// ImmediateModeVertex
+	RENDER_PIPELINE_SPRITE_FONT,	// SpriteFontVertex, textured
+
+	RENDER_PIPELINE_COUNT
+};
+
+struct RenderMatrices
+{
+	XMFLOAT4X4 model;
+	XMFLOAT4X4 view;
+	XMFLOAT4X4 projection;
+};
+
+// The backend's own handle for a texture; null draws untextured
+typedef void *RenderTexture;
+
+// A font made by a RenderDevice, which lays text out as glyph quads for
+// RENDER_PIPELINE_SPRITE_FONT
+class RenderFont
+{
+public:
+	virtual ~RenderFont() {}
+
+	// Two triangles per glyph are added to the end of vertices
+	virtual void BuildText(const char *text,
+		float x,
+		float y,
+		uint32_t colour,
+		std::vector<SpriteFontVertex> *vertices) const = 0;
+
+	virtual float GetLineSpacing() const = 0;
+	virtual float MeasureWidth(const char *text) const = 0;
+
+	virtual RenderTexture GetTexture() const = 0;
+};
+
+// Everything the renderer asks of the GPU. ImmediateMode and FontEngine
+// build their vertices and matrices on the CPU and hand them over here, so
+// only a backend knows which graphics API is underneath.
+class RenderDevice
+{
+public:
+	virtual ~RenderDevice() {}
+
+	virtual void BeginFrame() = 0;
+	virtual void EndFrame() = 0;
+
+	virtual void ClearFrame(float r, float g, float b, float a) = 0;
+
+	// The vertices are copied, so need only last the call. Returns false if
+	// the pipeline's vertex space for this frame has run out.
+	virtual bool Draw(RenderPipeline pipeline,
+		RenderTopology topology,
+		const RenderMatrices &matrices,
+		RenderTexture texture,
+		const void *vertices,
+		unsigned int vertexCount) = 0;
+
+	// Loads one of the application's font resources, or returns null if the
+	// backend cannot. Fonts go back through DestroyFont().
+	virtual RenderFont *LoadFont(int resourceId) = 0;
+	virtual void DestroyFont(RenderFont *font) = 0;
+
+	static unsigned int GetVertexSize(RenderPipeline pipeline);
+};
+
+#endif // RENDERDEVICE_H_INCLUDED
@@ -1,6 +1,7 @@
 #include "SpriteFontRenderer.h"
 
-SpriteFontRenderer::SpriteFontRenderer(uint32_t diffuse) :
+SpriteFontRenderer::SpriteFontRenderer(uint32_t diffuse, FontVertexVector *vertices) :
+	vertices_(vertices),
 	diffuse_(diffuse)
 {
 }
@@ -45,28 +46,11 @@ void SpriteFontRenderer::DrawGlyph(XMVECTOR position, const RECT *uvs)
 	// |/  /|
 	// 2  4-3
 
-	vertices_.push_back(topLeft);
-	vertices_.push_back(topRight);
-	vertices_.push_back(bottomLeft);
+	vertices_->push_back(topLeft);
+	vertices_->push_back(topRight);
+	vertices_->push_back(bottomLeft);
 
-	vertices_.push_back(bottomRight);
-	vertices_.push_back(bottomLeft);
-	vertices_.push_back(topRight);
-}
-
-bool SpriteFontRenderer::Flush(DynamicVertexBuffers *verts,
-	ID3D11DeviceContext *d3dDeviceContext,
-	DynamicVertexBuffers::VertexRange *copiedRange)
-{
-	if (vertices_.empty())
-		return false;
-
-	bool copied = verts->CopyVertexData<SpriteFontVertex>(&vertices_[0],
-		static_cast<unsigned int>(vertices_.size()),
-		d3dDeviceContext,
-		copiedRange);
-
-	vertices_.clear();
-
-	return copied;
+	vertices_->push_back(bottomRight);
+	vertices_->push_back(bottomLeft);
+	vertices_->push_back(topRight);
 }
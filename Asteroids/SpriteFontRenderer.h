@@ -2,7 +2,6 @@
 #define SPRITEFONTRENDERER_H_INCLUDED
 
 #include "SpriteFontVertex.h"
-#include "DynamicVertexBuffers.h"
 #include <DirectXMath.h>
 #include <SpriteFont.h>
 #include <vector>
@@ -15,18 +14,15 @@ class SpriteFontRenderer : public DirectX::ISpriteFontRenderer
 {
 public:
 
-	SpriteFontRenderer(uint32_t diffuse);
+	typedef std::vector<SpriteFontVertex> FontVertexVector;
 
-	virtual void DrawGlyph(XMVECTOR position, const RECT *uvs);
+	// Glyphs are added to the end of vertices
+	SpriteFontRenderer(uint32_t diffuse, FontVertexVector *vertices);
 
-	bool Flush(DynamicVertexBuffers *verts,
-		ID3D11DeviceContext *d3dDeviceContext,
-		DynamicVertexBuffers::VertexRange *copiedRange);
+	virtual void DrawGlyph(XMVECTOR position, const RECT *uvs);
 
 private:
-	typedef std::vector<SpriteFontVertex> FontVertexVector;
-
-	FontVertexVector vertices_;
+	FontVertexVector *vertices_;
 	uint32_t diffuse_;
 };
 
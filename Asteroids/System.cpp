@@ -1,18 +1,22 @@
 #include "System.h"
 #include "MainWindow.h"
 #include "ResourceLoader.h"
+#include "D3D11RenderDevice.h"
 #include "Graphics.h"
 #include "AssetLoader.h"
 #include "StateLibrary.h"
 #include "Keyboard.h"
 #include "GameState.h"
 #include "Game.h"
+#include "GameRenderer.h"
+#include "JobSystem.h"
 
 System::System(HINSTANCE hInstance) :
 	moduleInstance_(hInstance),
 	mainWindow_(0),
 	quit_(false),
 	resourceLoader_(0),
+	renderDevice_(0),
 	graphics_(0),
 	assetLoader_(0),
 	stateLibrary_(0),
@@ -20,7 +24,9 @@ System::System(HINSTANCE hInstance) :
 	mouse_(nullptr),
 	currentState_(0),
 	nextState_(0),
-	game_(0)
+	jobSystem_(0),
+	game_(0),
+	gameRenderer_(0)
 {
 }
 
@@ -32,13 +38,16 @@ void System::Initialise()
 {
 	mainWindow_ = new MainWindow(moduleInstance_);
 	resourceLoader_ = new ResourceLoader();
-	graphics_ = Graphics::CreateDevice(mainWindow_->GetHandle(), resourceLoader_);
+	renderDevice_ = D3D11RenderDevice::CreateDevice(mainWindow_->GetHandle(), resourceLoader_);
+	graphics_ = Graphics::CreateDevice(renderDevice_);
 	assetLoader_ = new AssetLoader();
 	stateLibrary_ = new StateLibrary();
 	keyboard_ = new Keyboard();
 	mouse_ = std::make_unique<DirectX::Mouse>();
 	mouse_->SetWindow(mainWindow_->GetHandle());
-	game_ = new Game();
+	jobSystem_ = JobSystem::Create(0);
+	game_ = new Game(jobSystem_);
+	gameRenderer_ = new GameRenderer();
 }
 
 void System::Test()
@@ -63,9 +72,15 @@ void System::Run()
 
 void System::Terminate()
 {
+	delete gameRenderer_;
+	gameRenderer_ = 0;
+
 	delete game_;
 	game_ = 0;
 
+	JobSystem::Destroy(jobSystem_);
+	jobSystem_ = 0;
+
 	delete keyboard_;
 	keyboard_ = 0;
 
@@ -78,6 +93,9 @@ void System::Terminate()
 	Graphics::DestroyDevice(graphics_);
 	graphics_ = 0;
 
+	D3D11RenderDevice::DestroyDevice(renderDevice_);
+	renderDevice_ = 0;
+
 	delete resourceLoader_;
 	resourceLoader_ = 0;
 
@@ -115,6 +133,11 @@ Game *System::GetGame() const
 	return game_;
 }
 
+GameRenderer *System::GetGameRenderer() const
+{
+	return gameRenderer_;
+}
+
 void System::SetNextState(const std::string &stateName)
 {
 	nextState_ = stateLibrary_->GetState(stateName);
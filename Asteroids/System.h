@@ -8,11 +8,14 @@
 
 class MainWindow;
 class ResourceLoader;
+class D3D11RenderDevice;
 class Graphics;
 class AssetLoader;
 class StateLibrary;
 class Keyboard;
 class Game;
+class GameRenderer;
+class JobSystem;
 
 class System
 {
@@ -31,6 +34,7 @@ public:
 	Keyboard *GetKeyboard() const;
 	DirectX::Mouse* GetMouse() const;
 	Game *GetGame() const;
+	GameRenderer *GetGameRenderer() const;
 
 	void SetNextState(const std::string &stateName);
 	void SetNextState(const std::string &stateName,
@@ -49,6 +53,7 @@ private:
 	MainWindow *mainWindow_;
 	bool quit_;
 	ResourceLoader *resourceLoader_;
+	D3D11RenderDevice *renderDevice_;
 	Graphics *graphics_;
 	AssetLoader *assetLoader_;
 	StateLibrary *stateLibrary_;
@@ -59,7 +64,9 @@ private:
 	GameState *nextState_;
 	GameState::StateArgumentMap nextStateArgs_;
 
+	JobSystem *jobSystem_;
 	Game *game_;
+	GameRenderer *gameRenderer_;
 };
 
 #endif // SYSTEM_H_INCLUDED
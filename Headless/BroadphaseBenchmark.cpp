@@ -0,0 +1,261 @@
+#include "GridBroadphase.h"
+#include "SweepAndPruneBroadphase.h"
+#include "AabbTreeBroadphase.h"
+#include "CollisionLayer.h"
+#include "MotionKernels.h"
+#include "Maths.h"
+#include "Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Times each broadphase against testing every pair, on the game's collider
+// mix: asteroids of radius 5 to 15, bullets of 3 and ships of 10 on the
+// game's layers, optionally with a few boss-sized colliders and scaled up.
+// Everything drifts and wraps each frame and a few colliders are replaced
+// with fresh proxy ids. Fails if a broadphase misses a pair that touches.
+namespace
+{
+	const WorldBounds BOUNDS = { -400.0f, 400.0f, -300.0f, 300.0f };
+
+	struct Mix
+	{
+		const char *name;
+		unsigned int asteroids;
+		unsigned int bullets;
+		unsigned int bosses;
+	};
+
+	struct Colliders
+	{
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<float> radius;
+		std::vector<unsigned int> proxyId;
+		std::vector<CollisionMask> layerBit;
+		std::vector<CollisionMask> mask;
+
+		void Add(Random &random, CollisionLayer layer, float colliderRadius, float speed)
+		{
+			float angle = random.NextFloat(Maths::TWO_PI);
+			positionX.push_back(random.NextFloat(BOUNDS.minX, BOUNDS.maxX));
+			positionY.push_back(random.NextFloat(BOUNDS.minY, BOUNDS.maxY));
+			velocityX.push_back(std::cos(angle) * speed);
+			velocityY.push_back(std::sin(angle) * speed);
+			radius.push_back(colliderRadius);
+			proxyId.push_back(static_cast<unsigned int>(proxyId.size()));
+			layerBit.push_back(CollisionLayerBit(layer));
+			mask.push_back(GetGameMask(layer));
+		}
+
+		unsigned int Size() const
+		{
+			return static_cast<unsigned int>(positionX.size());
+		}
+
+		// The pairs Game::SetupCollisionLayers turns on
+		static CollisionMask GetGameMask(CollisionLayer layer)
+		{
+			switch (layer)
+			{
+			case COLLISION_LAYER_PLAYER:
+				return CollisionLayerBit(COLLISION_LAYER_ASTEROID) |
+					CollisionLayerBit(COLLISION_LAYER_ENEMY) |
+					CollisionLayerBit(COLLISION_LAYER_ENEMY_BULLET);
+			case COLLISION_LAYER_ENEMY:
+				return CollisionLayerBit(COLLISION_LAYER_PLAYER) |
+					CollisionLayerBit(COLLISION_LAYER_PLAYER_BULLET);
+			case COLLISION_LAYER_ASTEROID:
+				return CollisionLayerBit(COLLISION_LAYER_PLAYER) |
+					CollisionLayerBit(COLLISION_LAYER_PLAYER_BULLET);
+			case COLLISION_LAYER_PLAYER_BULLET:
+				return CollisionLayerBit(COLLISION_LAYER_ENEMY) |
+					CollisionLayerBit(COLLISION_LAYER_ASTEROID);
+			case COLLISION_LAYER_ENEMY_BULLET:
+				return CollisionLayerBit(COLLISION_LAYER_PLAYER);
+			default:
+				return COLLISION_MASK_NONE;
+			}
+		}
+	};
+
+	double GetMilliseconds(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	bool Touches(const BroadphaseInput &input, unsigned int a, unsigned int b)
+	{
+		float width = input.bounds.GetWidth();
+		float height = input.bounds.GetHeight();
+		float dx = MotionKernels::WrapDelta(input.positionX[a] - input.positionX[b], width, 1.0f / width);
+		float dy = MotionKernels::WrapDelta(input.positionY[a] - input.positionY[b], height, 1.0f / height);
+		float radii = input.radius[a] + input.radius[b];
+		return dx * dx + dy * dy < radii * radii;
+	}
+
+	void FindPairsBruteForce(const BroadphaseInput &input, std::vector<ColliderPair> *pairs)
+	{
+		pairs->clear();
+		for (unsigned int a = 0; a < input.count; ++a)
+		{
+			for (unsigned int b = a + 1; b < input.count; ++b)
+			{
+				if (!LayersCollide(input, a, b) || !Touches(input, a, b))
+					continue;
+
+				ColliderPair pair;
+				pair.a = a;
+				pair.b = b;
+				pairs->push_back(pair);
+			}
+		}
+	}
+
+	// Broadphases may report pairs that do not touch, but never miss one
+	unsigned int CountMissed(const std::vector<ColliderPair> &touching, const std::vector<ColliderPair> &found)
+	{
+		unsigned int missed = 0;
+		for (std::vector<ColliderPair>::const_iterator pairIt = touching.begin(), end = touching.end();
+			pairIt != end;
+			++pairIt)
+		{
+			if (!std::binary_search(found.begin(), found.end(), *pairIt, ColliderPairLess))
+				++missed;
+		}
+		return missed;
+	}
+
+	bool RunMix(const Mix &mix, int frames, uint64_t seed)
+	{
+		const unsigned int CHURN_PER_FRAME = 4;
+
+		Random random(seed);
+		Colliders colliders;
+		colliders.Add(random, COLLISION_LAYER_PLAYER, 10.0f, 2.0f);
+		colliders.Add(random, COLLISION_LAYER_ENEMY, 10.0f, 2.0f);
+		for (unsigned int index = 0; index < mix.asteroids; ++index)
+		{
+			colliders.Add(random, COLLISION_LAYER_ASTEROID, 5.0f * (1 + index % 3), 1.0f);
+		}
+		for (unsigned int index = 0; index < mix.bullets; ++index)
+		{
+			colliders.Add(random, index % 4 == 0 ? COLLISION_LAYER_ENEMY_BULLET : COLLISION_LAYER_PLAYER_BULLET, 3.0f, 4.0f);
+		}
+		for (unsigned int index = 0; index < mix.bosses; ++index)
+		{
+			colliders.Add(random, COLLISION_LAYER_ENEMY, 80.0f, 0.5f);
+		}
+
+		GridBroadphase grid;
+		SweepAndPruneBroadphase sweepAndPrune;
+		AabbTreeBroadphase tree;
+		Broadphase *broadphases[] = { &grid, &sweepAndPrune, &tree };
+		const char *names[] = { "grid", "sap", "tree" };
+		const int numBroadphases = sizeof(broadphases) / sizeof(broadphases[0]);
+
+		double bruteMilliseconds = 0.0;
+		double milliseconds[numBroadphases] = { 0.0, 0.0, 0.0 };
+		unsigned int missed[numBroadphases] = { 0, 0, 0 };
+		unsigned int numTouching = 0;
+		unsigned int nextProxyId = colliders.Size();
+		std::vector<ColliderPair> touching;
+		std::vector<ColliderPair> found;
+
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			unsigned int count = colliders.Size();
+			MotionKernels::IntegrateWrap(colliders.positionX.data(), colliders.velocityX.data(), 1.0f, count, BOUNDS.minX, BOUNDS.maxX);
+			MotionKernels::IntegrateWrap(colliders.positionY.data(), colliders.velocityY.data(), 1.0f, count, BOUNDS.minY, BOUNDS.maxY);
+
+			// Some things die and others spawn somewhere else
+			for (unsigned int churn = 0; churn < CHURN_PER_FRAME; ++churn)
+			{
+				unsigned int index = random.NextUint() % count;
+				colliders.proxyId[index] = nextProxyId++;
+				colliders.positionX[index] = random.NextFloat(BOUNDS.minX, BOUNDS.maxX);
+				colliders.positionY[index] = random.NextFloat(BOUNDS.minY, BOUNDS.maxY);
+			}
+
+			BroadphaseInput input;
+			input.positionX = colliders.positionX.data();
+			input.positionY = colliders.positionY.data();
+			input.radius = colliders.radius.data();
+			input.proxyId = colliders.proxyId.data();
+			input.layerBit = colliders.layerBit.data();
+			input.mask = colliders.mask.data();
+			input.count = count;
+			input.bounds = BOUNDS;
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			FindPairsBruteForce(input, &touching);
+			bruteMilliseconds += GetMilliseconds(start);
+			numTouching += static_cast<unsigned int>(touching.size());
+
+			for (int broadphase = 0; broadphase < numBroadphases; ++broadphase)
+			{
+				start = std::chrono::steady_clock::now();
+				broadphases[broadphase]->FindPairs(input, nullptr, &found);
+				milliseconds[broadphase] += GetMilliseconds(start);
+
+				std::sort(found.begin(), found.end(), ColliderPairLess);
+				missed[broadphase] += CountMissed(touching, found);
+			}
+		}
+
+		printf("%s: colliders=%u touching/frame=%.1f brute=%.3fms", mix.name, colliders.Size(),
+			static_cast<double>(numTouching) / frames, bruteMilliseconds / frames);
+		bool ok = true;
+		for (int broadphase = 0; broadphase < numBroadphases; ++broadphase)
+		{
+			printf(" %s=%.3fms", names[broadphase], milliseconds[broadphase] / frames);
+			if (missed[broadphase] > 0)
+			{
+				printf(" (%s MISSED %u)", names[broadphase], missed[broadphase]);
+				ok = false;
+			}
+		}
+		printf(" treeHeight=%d\n", tree.GetTree().GetHeight());
+		return ok;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int frames = 200;
+	uint64_t seed = Random::DEFAULT_SEED;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--frames") == 0)
+			frames = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--seed") == 0)
+			seed = strtoull(argv[i + 1], 0, 10);
+		else
+		{
+			printf("Usage: BroadphaseBenchmark [--frames N] [--seed N]\n");
+			return 1;
+		}
+	}
+
+	// World's capacities are 256 asteroids and 256 bullets
+	const Mix mixes[] =
+	{
+		{ "level", 30, 20, 0 },
+		{ "full", 256, 256, 0 },
+		{ "full+bosses", 256, 256, 4 },
+		{ "scaled+bosses", 2000, 500, 4 },
+	};
+
+	bool ok = true;
+	for (unsigned int mix = 0; mix < sizeof(mixes) / sizeof(mixes[0]); ++mix)
+	{
+		ok = RunMix(mixes[mix], frames, seed) && ok;
+	}
+	return ok ? 0 : 1;
+}
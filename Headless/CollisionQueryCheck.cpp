@@ -0,0 +1,460 @@
+#include "Collision.h"
+#include "MotionKernels.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Checks Collision's spatial queries against scanning every collider, under
+// each broadphase. Colliders respawn, move and are switched off between
+// passes, so with the grid or sweep and prune finding the pairs the queries
+// only pass if the tree is refitted after FindContacts(). A few colliders on
+// a layer of their own sit across the world edges for cases with known
+// answers: a circle, a ray and a nearest search that only reach them by
+// wrapping, a nearest search from inside one, and a ray that stops short.
+namespace
+{
+	const WorldBounds BOUNDS = { -400.0f, 400.0f, -300.0f, 300.0f };
+	const float DISTANCE_TOLERANCE = 1e-3f;
+
+	struct Body
+	{
+		ColliderHandle handle;
+		XMFLOAT2 position;
+		float radius;
+		CollisionLayer layer;
+		bool enabled;
+	};
+
+	bool HandleLess(const ColliderHandle &lhs, const ColliderHandle &rhs)
+	{
+		if (lhs.index != rhs.index)
+			return lhs.index < rhs.index;
+		return lhs.generation < rhs.generation;
+	}
+
+	XMFLOAT2 GetWrappedOffset(const XMFLOAT2 &from, const XMFLOAT2 &to)
+	{
+		float width = BOUNDS.GetWidth();
+		float height = BOUNDS.GetHeight();
+		return XMFLOAT2(MotionKernels::WrapDelta(to.x - from.x, width, 1.0f / width),
+			MotionKernels::WrapDelta(to.y - from.y, height, 1.0f / height));
+	}
+
+	bool IsFound(const Body &body, CollisionMask layers)
+	{
+		return body.enabled && (CollisionLayerBit(body.layer) & layers) != 0;
+	}
+
+	// The scans each query should agree with
+
+	void OverlapCircleBruteForce(const std::vector<Body> &bodies, const XMFLOAT2 &centre, float radius,
+		CollisionMask layers, std::vector<ColliderHandle> *found)
+	{
+		found->clear();
+		for (std::vector<Body>::const_iterator bodyIt = bodies.begin(), end = bodies.end(); bodyIt != end; ++bodyIt)
+		{
+			if (!IsFound(*bodyIt, layers))
+				continue;
+
+			XMFLOAT2 offset = GetWrappedOffset(centre, bodyIt->position);
+			float reach = radius + bodyIt->radius;
+			if (offset.x * offset.x + offset.y * offset.y < reach * reach)
+				found->push_back(bodyIt->handle);
+		}
+		std::sort(found->begin(), found->end(), HandleLess);
+	}
+
+	struct Nearest
+	{
+		ColliderHandle handle;
+		float distance;
+
+		bool operator<(const Nearest &other) const
+		{
+			if (distance != other.distance)
+				return distance < other.distance;
+			return handle.index < other.handle.index;
+		}
+	};
+
+	void FindNearestBruteForce(const std::vector<Body> &bodies, const XMFLOAT2 &point, CollisionMask layers,
+		std::vector<Nearest> *nearest)
+	{
+		nearest->clear();
+		for (std::vector<Body>::const_iterator bodyIt = bodies.begin(), end = bodies.end(); bodyIt != end; ++bodyIt)
+		{
+			if (!IsFound(*bodyIt, layers))
+				continue;
+
+			XMFLOAT2 offset = GetWrappedOffset(point, bodyIt->position);
+			Nearest entry;
+			entry.handle = bodyIt->handle;
+			entry.distance = std::max(std::sqrt(offset.x * offset.x + offset.y * offset.y) - bodyIt->radius, 0.0f);
+			nearest->push_back(entry);
+		}
+		std::sort(nearest->begin(), nearest->end());
+	}
+
+	// Every copy of every circle within two world sizes of where it is
+	bool RaycastBruteForce(const std::vector<Body> &bodies, const XMFLOAT2 &origin, const XMFLOAT2 &direction,
+		float maxDistance, CollisionMask layers, ColliderHandle *hitCollider, float *hitDistance)
+	{
+		const int COPIES = 2;
+
+		float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+		float directionX = direction.x / length;
+		float directionY = direction.y / length;
+
+		bool found = false;
+		*hitDistance = maxDistance;
+		for (std::vector<Body>::const_iterator bodyIt = bodies.begin(), end = bodies.end(); bodyIt != end; ++bodyIt)
+		{
+			if (!IsFound(*bodyIt, layers))
+				continue;
+
+			for (int copyX = -COPIES; copyX <= COPIES; ++copyX)
+			{
+				for (int copyY = -COPIES; copyY <= COPIES; ++copyY)
+				{
+					float offsetX = origin.x - (bodyIt->position.x + copyX * BOUNDS.GetWidth());
+					float offsetY = origin.y - (bodyIt->position.y + copyY * BOUNDS.GetHeight());
+					float along = offsetX * directionX + offsetY * directionY;
+					float excess = offsetX * offsetX + offsetY * offsetY - bodyIt->radius * bodyIt->radius;
+
+					float t = 0.0f;
+					if (excess > 0.0f)
+					{
+						float discriminant = along * along - excess;
+						if (along > 0.0f || discriminant < 0.0f)
+							continue;
+
+						t = -along - std::sqrt(discriminant);
+					}
+
+					if (t > *hitDistance || (found && t == *hitDistance && bodyIt->handle.index >= hitCollider->index))
+						continue;
+
+					found = true;
+					*hitCollider = bodyIt->handle;
+					*hitDistance = t;
+				}
+			}
+		}
+		return found;
+	}
+
+	class Checker
+	{
+	public:
+		Checker(BroadphaseType broadphase, const char *name) :
+			collision_(1024, POOL_OVERFLOW_GROW, BOUNDS, nullptr),
+			name_(name),
+			failures_(0),
+			numQueries_(0)
+		{
+			collision_.SetBroadphase(broadphase);
+		}
+
+		bool Run(uint64_t seed, int rounds, int queriesPerRound)
+		{
+			const unsigned int NUM_BODIES = 400;
+			const unsigned int CHURN_PER_ROUND = 8;
+
+			Random random(seed);
+			for (unsigned int index = 0; index < NUM_BODIES; ++index)
+			{
+				AddRandomBody(random);
+			}
+
+			AddEdgeBodies();
+
+			for (int round = 0; round < rounds; ++round)
+			{
+				// Respawns, moves and switches on and off, all after the tree
+				// was last brought up to date
+				collision_.ApplyPendingChanges();
+				if (round > 0)
+				{
+					for (unsigned int churn = 0; churn < CHURN_PER_ROUND; ++churn)
+					{
+						DestroyBody(FIRST_RANDOM_BODY + random.NextUint() % (bodies_.size() - FIRST_RANDOM_BODY));
+						AddRandomBody(random);
+					}
+
+					for (unsigned int index = FIRST_RANDOM_BODY; index < bodies_.size(); ++index)
+					{
+						Body &body = bodies_[index];
+						body.position.x = MotionKernels::WrapValue(body.position.x + random.NextFloat(-40.0f, 40.0f), BOUNDS.minX, BOUNDS.maxX);
+						body.position.y = MotionKernels::WrapValue(body.position.y + random.NextFloat(-40.0f, 40.0f), BOUNDS.minY, BOUNDS.maxY);
+						collision_.UpdateColliderPosition(body.handle, XMFLOAT3(body.position.x, body.position.y, 0.0f));
+
+						if (random.NextUint() % 16 == 0)
+							SetBodyEnabled(&body, !body.enabled);
+					}
+				}
+
+				collision_.FindContacts();
+
+				// Gone or switched off since the pass, so never found
+				DestroyBody(FIRST_RANDOM_BODY + random.NextUint() % (bodies_.size() - FIRST_RANDOM_BODY));
+				SetBodyEnabled(&bodies_[FIRST_RANDOM_BODY + random.NextUint() % (bodies_.size() - FIRST_RANDOM_BODY)], false);
+
+				for (int query = 0; query < queriesPerRound; ++query)
+				{
+					RunRandomQueries(random);
+				}
+
+				CheckEdgeCases();
+			}
+
+			printf("%s: rounds=%d queries=%u %s\n", name_, rounds, numQueries_,
+				failures_ == 0 ? "ok" : "FAILED");
+			return failures_ == 0;
+		}
+
+	private:
+		// The edge bodies come first and stay put
+		enum
+		{
+			EDGE_RIGHT,
+			EDGE_CORNER,
+			EDGE_LEFT,
+
+			FIRST_RANDOM_BODY
+		};
+
+		void AddBody(float x, float y, float radius, CollisionLayer layer)
+		{
+			Body body;
+			body.handle = collision_.CreateCollider(ENTITY_TYPE_ASTEROID, EntityHandle(), layer);
+			body.position = XMFLOAT2(x, y);
+			body.radius = radius;
+			body.layer = layer;
+			body.enabled = true;
+			collision_.UpdateColliderPosition(body.handle, XMFLOAT3(x, y, 0.0f));
+			collision_.UpdateColliderRadius(body.handle, radius);
+			bodies_.push_back(body);
+		}
+
+		void AddRandomBody(Random &random)
+		{
+			const CollisionLayer LAYERS[] = { COLLISION_LAYER_ASTEROID, COLLISION_LAYER_PLAYER_BULLET, COLLISION_LAYER_ENEMY };
+			AddBody(random.NextFloat(BOUNDS.minX, BOUNDS.maxX),
+				random.NextFloat(BOUNDS.minY, BOUNDS.maxY),
+				random.NextFloat(3.0f, 30.0f),
+				LAYERS[random.NextUint() % 3]);
+		}
+
+		// On the player layer, which nothing else is on
+		void AddEdgeBodies()
+		{
+			std::vector<Body> randomBodies(bodies_.begin(), bodies_.end());
+			bodies_.clear();
+			AddBody(395.0f, 0.0f, 10.0f, COLLISION_LAYER_PLAYER);
+			AddBody(-390.0f, 295.0f, 8.0f, COLLISION_LAYER_PLAYER);
+			AddBody(-390.0f, 100.0f, 6.0f, COLLISION_LAYER_PLAYER);
+			bodies_.insert(bodies_.end(), randomBodies.begin(), randomBodies.end());
+		}
+
+		void DestroyBody(size_t index)
+		{
+			collision_.DestroyCollider(bodies_[index].handle);
+			bodies_[index] = bodies_.back();
+			bodies_.pop_back();
+		}
+
+		void SetBodyEnabled(Body *body, bool enabled)
+		{
+			body->enabled = enabled;
+			if (enabled)
+				collision_.EnableCollider(body->handle);
+			else
+				collision_.DisableCollider(body->handle);
+		}
+
+		void Fail(const char *query, const char *detail)
+		{
+			if (failures_ < 10)
+				printf("%s: FAILED %s: %s\n", name_, query, detail);
+			++failures_;
+		}
+
+		CollisionMask GetRandomLayers(Random &random) const
+		{
+			const CollisionMask MASKS[] =
+			{
+				COLLISION_MASK_ALL,
+				CollisionLayerBit(COLLISION_LAYER_ASTEROID),
+				CollisionLayerBit(COLLISION_LAYER_ASTEROID) | CollisionLayerBit(COLLISION_LAYER_ENEMY),
+				CollisionLayerBit(COLLISION_LAYER_PLAYER) | CollisionLayerBit(COLLISION_LAYER_PLAYER_BULLET),
+			};
+			return MASKS[random.NextUint() % (sizeof(MASKS) / sizeof(MASKS[0]))];
+		}
+
+		void RunRandomQueries(Random &random)
+		{
+			XMFLOAT2 point(random.NextFloat(BOUNDS.minX, BOUNDS.maxX), random.NextFloat(BOUNDS.minY, BOUNDS.maxY));
+			CheckOverlapCircle(point, random.NextFloat(1.0f, 80.0f), GetRandomLayers(random));
+			CheckFindNearest(point, GetRandomLayers(random), 1 + random.NextUint() % 16);
+
+			float angle = random.NextFloat(6.2831853f);
+			CheckRaycast(point, XMFLOAT2(std::cos(angle), std::sin(angle)), random.NextFloat(0.0f, 500.0f),
+				GetRandomLayers(random));
+		}
+
+		void CheckOverlapCircle(const XMFLOAT2 &centre, float radius, CollisionMask layers)
+		{
+			++numQueries_;
+			ColliderHandle colliders[1024];
+			unsigned int count = collision_.OverlapCircle(centre, radius, layers, colliders, 1024);
+			std::vector<ColliderHandle> found(colliders, colliders + count);
+			std::sort(found.begin(), found.end(), HandleLess);
+
+			OverlapCircleBruteForce(bodies_, centre, radius, layers, &expected_);
+			if (found != expected_)
+			{
+				char detail[128];
+				sprintf(detail, "at (%.1f, %.1f) radius %.1f found %u, expected %u",
+					centre.x, centre.y, radius, count, static_cast<unsigned int>(expected_.size()));
+				Fail("OverlapCircle", detail);
+			}
+		}
+
+		void CheckFindNearest(const XMFLOAT2 &point, CollisionMask layers, unsigned int maxResults)
+		{
+			++numQueries_;
+			ColliderHandle colliders[16];
+			float distances[16];
+			unsigned int count = collision_.FindNearest(point, layers, colliders, distances, maxResults);
+
+			FindNearestBruteForce(bodies_, point, layers, &nearest_);
+			unsigned int expectedCount = std::min(maxResults, static_cast<unsigned int>(nearest_.size()));
+			bool ok = count == expectedCount;
+			for (unsigned int index = 0; ok && index < count; ++index)
+			{
+				ok = colliders[index] == nearest_[index].handle &&
+					std::fabs(distances[index] - nearest_[index].distance) <= DISTANCE_TOLERANCE;
+			}
+
+			if (!ok)
+			{
+				char detail[128];
+				sprintf(detail, "at (%.1f, %.1f) for %u found %u, expected %u",
+					point.x, point.y, maxResults, count, expectedCount);
+				Fail("FindNearest", detail);
+			}
+		}
+
+		void CheckRaycast(const XMFLOAT2 &origin, const XMFLOAT2 &direction, float maxDistance, CollisionMask layers)
+		{
+			++numQueries_;
+			RaycastHit hit;
+			bool found = collision_.Raycast(origin, direction, maxDistance, layers, &hit);
+
+			ColliderHandle expectedCollider;
+			float expectedDistance;
+			bool expectedFound = RaycastBruteForce(bodies_, origin, direction, maxDistance, layers,
+				&expectedCollider, &expectedDistance);
+			if (found != expectedFound ||
+				(found && (hit.collider != expectedCollider || std::fabs(hit.distance - expectedDistance) > DISTANCE_TOLERANCE)))
+			{
+				char detail[128];
+				sprintf(detail, "from (%.1f, %.1f) along (%.2f, %.2f) for %.1f hit %d, expected %d",
+					origin.x, origin.y, direction.x, direction.y, maxDistance, found ? 1 : 0, expectedFound ? 1 : 0);
+				Fail("Raycast", detail);
+			}
+		}
+
+		void CheckEdgeCases()
+		{
+			const CollisionMask EDGE_LAYER = CollisionLayerBit(COLLISION_LAYER_PLAYER);
+			const Body &right = bodies_[EDGE_RIGHT];
+			const Body &corner = bodies_[EDGE_CORNER];
+			const Body &left = bodies_[EDGE_LEFT];
+
+			// Only across the left and right edges
+			ColliderHandle colliders[4];
+			unsigned int count = collision_.OverlapCircle(XMFLOAT2(-398.0f, 0.0f), 6.0f, EDGE_LAYER, colliders, 4);
+			if (count != 1 || colliders[0] != right.handle)
+				Fail("OverlapCircle", "missed the collider across the left edge");
+
+			// Only across the corner
+			float distances[4];
+			count = collision_.FindNearest(XMFLOAT2(398.0f, -298.0f), EDGE_LAYER, colliders, distances, 3);
+			float cornerDistance = std::sqrt(12.0f * 12.0f + 7.0f * 7.0f) - corner.radius;
+			if (count != 3 || colliders[0] != corner.handle || std::fabs(distances[0] - cornerDistance) > DISTANCE_TOLERANCE)
+				Fail("FindNearest", "missed the collider across the corner");
+			for (unsigned int index = 1; index < count; ++index)
+			{
+				if (distances[index] < distances[index - 1])
+					Fail("FindNearest", "results out of order");
+			}
+
+			// From inside, where the distance is 0
+			count = collision_.FindNearest(right.position, EDGE_LAYER, colliders, distances, 1);
+			if (count != 1 || colliders[0] != right.handle || distances[0] != 0.0f)
+				Fail("FindNearest", "inside a collider is not distance 0");
+
+			// Out over the right edge to the left collider, 24 away
+			RaycastHit hit;
+			XMFLOAT2 origin(380.0f, 100.0f);
+			XMFLOAT2 direction(1.0f, 0.0f);
+			float leftDistance = (left.position.x + BOUNDS.GetWidth() - left.radius) - origin.x;
+			if (!collision_.Raycast(origin, direction, 100.0f, EDGE_LAYER, &hit) ||
+				hit.collider != left.handle ||
+				std::fabs(hit.distance - leftDistance) > DISTANCE_TOLERANCE ||
+				std::fabs(hit.point.x - (left.position.x - left.radius)) > DISTANCE_TOLERANCE)
+			{
+				Fail("Raycast", "missed the collider across the right edge");
+			}
+
+			// The same ray stopping short of it
+			if (collision_.Raycast(origin, direction, leftDistance - 1.0f, EDGE_LAYER, &hit))
+				Fail("Raycast", "hit beyond maxDistance");
+		}
+
+		Collision collision_;
+		const char *name_;
+		std::vector<Body> bodies_;
+		std::vector<ColliderHandle> expected_;
+		std::vector<Nearest> nearest_;
+		unsigned int failures_;
+		unsigned int numQueries_;
+	};
+}
+
+int main(int argc, char **argv)
+{
+	int rounds = 8;
+	int queries = 200;
+	uint64_t seed = Random::DEFAULT_SEED;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--rounds") == 0)
+			rounds = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--queries") == 0)
+			queries = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--seed") == 0)
+			seed = strtoull(argv[i + 1], 0, 10);
+		else
+		{
+			printf("Usage: CollisionQueryCheck [--rounds N] [--queries N] [--seed N]\n");
+			return 1;
+		}
+	}
+
+	const BroadphaseType broadphases[] = { BROADPHASE_GRID, BROADPHASE_SWEEP_AND_PRUNE, BROADPHASE_AABB_TREE };
+	const char *names[] = { "grid", "sap", "tree" };
+
+	bool ok = true;
+	for (int broadphase = 0; broadphase < 3; ++broadphase)
+	{
+		Checker checker(broadphases[broadphase], names[broadphase]);
+		ok = checker.Run(seed, rounds, queries) && ok;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,470 @@
+#include "Game.h"
+#include "Collision.h"
+#include "JobSystem.h"
+#include "MotionKernels.h"
+#include "Maths.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Runs the game with no window or renderer, as fast as it will go, with the
+// ship turning, thrusting and firing scatter shots. Prints how the run ended
+// and checksums of the asteroid and particle positions. With
+// --check-determinism it runs the same seed on every thread count,
+// broadphase and SIMD path and fails unless they all end identically. With
+// --check-tick-rates it runs at several tick rates and fails unless the
+// asteroids end up in the same places and a fixed volley of bullets scores
+// the same number of hits at every rate.
+namespace
+{
+	struct Options
+	{
+		Options() :
+			ticks(20000),
+			level(5),
+			threads(-1),
+			broadphase(BROADPHASE_GRID),
+			path(MotionKernels::GetBestSupportedPath()),
+			seed(Random::DEFAULT_SEED),
+			tickRate(1.0f / SimClock::DEFAULT_TICK_SECONDS),
+			checkDeterminism(false),
+			checkTickRates(false)
+		{
+		}
+
+		int ticks;
+		int level;
+		int threads;
+		BroadphaseType broadphase;
+		MotionKernels::Path path;
+		uint64_t seed;
+		float tickRate;
+		bool checkDeterminism;
+		bool checkTickRates;
+	};
+
+	struct RunResult
+	{
+		int ticks;
+		int score;
+		bool gameOver;
+		bool levelComplete;
+		unsigned int asteroids;
+		double asteroidChecksum;
+		double particleChecksum;
+		double milliseconds;
+	};
+
+	void PrintUsage()
+	{
+		printf("Usage: HeadlessSimulation [--ticks N] [--level ASTEROIDS] [--threads N]\n"
+			"    [--broadphase grid|sap|tree] [--simd scalar|sse2|avx2] [--seed N]\n"
+			"    [--tick-rate HZ] [--check-determinism] [--check-tick-rates]\n"
+			"--threads -1 runs without a job system; 0 uses one worker per core.\n");
+	}
+
+	bool ParseOptions(int argc, char **argv, Options *options)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char *name = argv[i];
+			if (strcmp(name, "--check-determinism") == 0)
+			{
+				options->checkDeterminism = true;
+				continue;
+			}
+			if (strcmp(name, "--check-tick-rates") == 0)
+			{
+				options->checkTickRates = true;
+				continue;
+			}
+
+			const char *value = (i + 1 < argc) ? argv[i + 1] : 0;
+			if (value == 0)
+				return false;
+			i++;
+
+			if (strcmp(name, "--ticks") == 0)
+				options->ticks = atoi(value);
+			else if (strcmp(name, "--level") == 0)
+				options->level = atoi(value);
+			else if (strcmp(name, "--threads") == 0)
+				options->threads = atoi(value);
+			else if (strcmp(name, "--seed") == 0)
+				options->seed = strtoull(value, 0, 10);
+			else if (strcmp(name, "--tick-rate") == 0)
+				options->tickRate = static_cast<float>(atof(value));
+			else if (strcmp(name, "--broadphase") == 0)
+			{
+				if (strcmp(value, "grid") == 0)
+					options->broadphase = BROADPHASE_GRID;
+				else if (strcmp(value, "sap") == 0)
+					options->broadphase = BROADPHASE_SWEEP_AND_PRUNE;
+				else if (strcmp(value, "tree") == 0)
+					options->broadphase = BROADPHASE_AABB_TREE;
+				else
+					return false;
+			}
+			else if (strcmp(name, "--simd") == 0)
+			{
+				if (strcmp(value, "scalar") == 0)
+					options->path = MotionKernels::PATH_SCALAR;
+				else if (strcmp(value, "sse2") == 0)
+					options->path = MotionKernels::PATH_SSE2;
+				else if (strcmp(value, "avx2") == 0)
+					options->path = MotionKernels::PATH_AVX2;
+				else
+					return false;
+			}
+			else
+				return false;
+		}
+		return options->tickRate > 0.0f;
+	}
+
+	RunResult Run(const Options &options)
+	{
+		MotionKernels::SetPath(options.path);
+
+		JobSystem *jobs = (options.threads >= 0) ? JobSystem::Create(options.threads) : nullptr;
+		Game *game = new Game(jobs);
+		game->SetRandomSeed(options.seed);
+		game->SetBroadphase(options.broadphase);
+		game->SetTickRate(options.tickRate);
+		game->InitialiseLevel(options.level);
+
+		GameInput input;
+		input.fire = true;
+		input.rotation = 1.0f;
+		input.acceleration = 0.5f;
+		input.fireMode = GameInput::FIRE_MODE_SCATTER;
+
+		RunResult result;
+		result.asteroidChecksum = 0.0;
+		result.particleChecksum = 0.0;
+		std::vector<float> particlesX;
+		std::vector<float> particlesY;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		int tick = 0;
+		for (; tick < options.ticks; ++tick)
+		{
+			game->Update(input);
+			input.fireMode = GameInput::FIRE_MODE_UNCHANGED;
+
+			const World &world = game->GetWorld();
+			for (unsigned int index = 0; index < world.asteroids.Size(); ++index)
+			{
+				result.asteroidChecksum += world.asteroids.positionX[index] * (index + 1);
+			}
+
+			unsigned int maxParticles = world.particles.GetMaxAnalyticParticles();
+			particlesX.resize(maxParticles);
+			particlesY.resize(maxParticles);
+			unsigned int numParticles = world.particles.EvaluateAnalytic(game->GetClock().GetTime(),
+				particlesX.data(), particlesY.data(), maxParticles);
+			for (unsigned int index = 0; index < numParticles; ++index)
+			{
+				result.particleChecksum += particlesX[index] + 0.5 * particlesY[index];
+			}
+
+			if (game->IsGameOver() || game->IsLevelComplete())
+				break;
+		}
+		result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		result.ticks = tick;
+		result.score = game->GetScore();
+		result.gameOver = game->IsGameOver();
+		result.levelComplete = game->IsLevelComplete();
+		result.asteroids = game->GetWorld().asteroids.Size();
+
+		delete game;
+		if (jobs)
+			JobSystem::Destroy(jobs);
+		return result;
+	}
+
+	void PrintResult(const RunResult &result)
+	{
+		printf("ticks=%d score=%d over=%d complete=%d asteroids=%u checksum=%.3f particles=%.4f ms=%.1f\n",
+			result.ticks,
+			result.score,
+			result.gameOver ? 1 : 0,
+			result.levelComplete ? 1 : 0,
+			result.asteroids,
+			result.asteroidChecksum,
+			result.particleChecksum,
+			result.milliseconds);
+	}
+
+	bool IsSameRun(const RunResult &a, const RunResult &b)
+	{
+		return a.ticks == b.ticks &&
+			a.score == b.score &&
+			a.gameOver == b.gameOver &&
+			a.levelComplete == b.levelComplete &&
+			a.asteroids == b.asteroids &&
+			a.asteroidChecksum == b.asteroidChecksum &&
+			a.particleChecksum == b.particleChecksum;
+	}
+
+	int CheckDeterminism(const Options &baseOptions)
+	{
+		Options options = baseOptions;
+		options.threads = -1;
+		options.broadphase = BROADPHASE_GRID;
+		options.path = MotionKernels::PATH_SCALAR;
+		RunResult reference = Run(options);
+		PrintResult(reference);
+
+		const int threadCounts[] = { -1, 1, 4 };
+		const BroadphaseType broadphases[] = { BROADPHASE_GRID, BROADPHASE_SWEEP_AND_PRUNE, BROADPHASE_AABB_TREE };
+		int failures = 0;
+		for (int path = MotionKernels::PATH_SCALAR; path <= MotionKernels::GetBestSupportedPath(); ++path)
+		{
+			for (int threads = 0; threads < 3; ++threads)
+			{
+				for (int broadphase = 0; broadphase < 3; ++broadphase)
+				{
+					options.path = static_cast<MotionKernels::Path>(path);
+					options.threads = threadCounts[threads];
+					options.broadphase = broadphases[broadphase];
+					RunResult result = Run(options);
+					if (!IsSameRun(reference, result))
+					{
+						printf("MISMATCH simd=%d threads=%d broadphase=%d: ", path, options.threads, broadphase);
+						PrintResult(result);
+						++failures;
+					}
+				}
+			}
+		}
+
+		printf("%s\n", failures == 0 ? "deterministic" : "NOT deterministic");
+		return failures == 0 ? 0 : 1;
+	}
+
+	// Where the asteroids are after simulating seconds with the ship idle
+	void RunIdle(const Options &options, float tickRate, float seconds,
+		std::vector<float> *positionsX, std::vector<float> *positionsY)
+	{
+		Game *game = new Game();
+		game->SetRandomSeed(options.seed);
+		game->SetBroadphase(options.broadphase);
+		game->SetTickRate(tickRate);
+		game->InitialiseLevel(options.level);
+
+		GameInput input;
+		int ticks = static_cast<int>(std::floor(seconds * tickRate + 0.5f));
+		for (int tick = 0; tick < ticks; ++tick)
+		{
+			game->Update(input);
+		}
+
+		const World::AsteroidArrays &asteroids = game->GetWorld().asteroids;
+		positionsX->assign(asteroids.positionX.begin(), asteroids.positionX.end());
+		positionsY->assign(asteroids.positionY.begin(), asteroids.positionY.end());
+		delete game;
+	}
+
+	// A shooting gallery on Collision alone: targets the size of the smallest
+	// asteroids drift about and volleys of game-speed bullets are fired at
+	// fixed times, each bullet living one second or until its first hit.
+	// Everything moves with the game's kernels and per-tick rates, and every
+	// rate tried fires on whole ticks. Returns how many bullets hit.
+	unsigned int RunGallery(uint64_t seed, int tickRate, bool swept)
+	{
+		const WorldBounds BOUNDS = { -400.0f, 400.0f, -300.0f, 300.0f };
+		const unsigned int NUM_TARGETS = 200;
+		const float TARGET_RADIUS = 5.0f;
+		const float TARGET_SPEED = 1.0f;
+		const int VOLLEYS_PER_SECOND = 5;
+		const int NUM_VOLLEYS = 50;
+		const unsigned int BULLETS_PER_VOLLEY = 16;
+		const float BULLET_RADIUS = 3.0f;
+		const float BULLET_SPEED = 4.0f;
+		const unsigned int NUM_BULLETS = NUM_VOLLEYS * BULLETS_PER_VOLLEY;
+
+		Collision collision(NUM_TARGETS + NUM_BULLETS, POOL_OVERFLOW_GROW, BOUNDS, nullptr);
+		collision.SetLayersCollide(COLLISION_LAYER_ASTEROID, COLLISION_LAYER_ASTEROID, false);
+		collision.SetLayersCollide(COLLISION_LAYER_PLAYER_BULLET, COLLISION_LAYER_PLAYER_BULLET, false);
+
+		Random random(seed);
+		std::vector<float> targetX(NUM_TARGETS), targetY(NUM_TARGETS);
+		std::vector<float> targetVelocityX(NUM_TARGETS), targetVelocityY(NUM_TARGETS);
+		std::vector<ColliderHandle> targets(NUM_TARGETS);
+		for (unsigned int index = 0; index < NUM_TARGETS; ++index)
+		{
+			float angle = random.NextFloat(Maths::TWO_PI);
+			float speed = random.NextFloat(TARGET_SPEED);
+			targetX[index] = random.NextFloat(BOUNDS.minX, BOUNDS.maxX);
+			targetY[index] = random.NextFloat(BOUNDS.minY, BOUNDS.maxY);
+			targetVelocityX[index] = std::cos(angle) * speed;
+			targetVelocityY[index] = std::sin(angle) * speed;
+
+			targets[index] = collision.CreateCollider(ENTITY_TYPE_ASTEROID, EntityHandle(index, 0), COLLISION_LAYER_ASTEROID);
+			collision.UpdateColliderPosition(targets[index], XMFLOAT3(targetX[index], targetY[index], 0.0f));
+			collision.UpdateColliderRadius(targets[index], TARGET_RADIUS);
+			collision.SetColliderSwept(targets[index], swept);
+		}
+
+		// Bullets keep their slot for the whole run and are switched on when fired
+		std::vector<float> bulletX(NUM_BULLETS), bulletY(NUM_BULLETS);
+		std::vector<float> bulletVelocityX(NUM_BULLETS), bulletVelocityY(NUM_BULLETS);
+		std::vector<ColliderHandle> bullets(NUM_BULLETS);
+		std::vector<int> bulletAge(NUM_BULLETS, -1);
+		for (unsigned int index = 0; index < NUM_BULLETS; ++index)
+		{
+			float angle = random.NextFloat(Maths::TWO_PI);
+			bulletX[index] = random.NextFloat(BOUNDS.minX, BOUNDS.maxX);
+			bulletY[index] = random.NextFloat(BOUNDS.minY, BOUNDS.maxY);
+			bulletVelocityX[index] = std::cos(angle) * BULLET_SPEED;
+			bulletVelocityY[index] = std::sin(angle) * BULLET_SPEED;
+		}
+
+		SimClock clock(1.0f / tickRate);
+		float stepScale = clock.GetStepScale();
+		int ticksPerVolley = tickRate / VOLLEYS_PER_SECOND;
+		int lifeTicks = tickRate;
+		unsigned int fired = 0;
+		unsigned int hits = 0;
+
+		int numTicks = NUM_VOLLEYS * ticksPerVolley + lifeTicks;
+		for (int tick = 0; tick < numTicks; ++tick)
+		{
+			if (tick % ticksPerVolley == 0 && fired < NUM_BULLETS)
+			{
+				for (unsigned int shot = 0; shot < BULLETS_PER_VOLLEY; ++shot, ++fired)
+				{
+					bullets[fired] = collision.CreateCollider(ENTITY_TYPE_BULLET, EntityHandle(fired, 0), COLLISION_LAYER_PLAYER_BULLET);
+					collision.UpdateColliderPosition(bullets[fired], XMFLOAT3(bulletX[fired], bulletY[fired], 0.0f));
+					collision.UpdateColliderRadius(bullets[fired], BULLET_RADIUS);
+					collision.SetColliderSwept(bullets[fired], swept);
+					bulletAge[fired] = 0;
+				}
+			}
+
+			MotionKernels::IntegrateWrap(targetX.data(), targetVelocityX.data(), stepScale, NUM_TARGETS, BOUNDS.minX, BOUNDS.maxX);
+			MotionKernels::IntegrateWrap(targetY.data(), targetVelocityY.data(), stepScale, NUM_TARGETS, BOUNDS.minY, BOUNDS.maxY);
+			MotionKernels::IntegrateWrap(bulletX.data(), bulletVelocityX.data(), stepScale, fired, BOUNDS.minX, BOUNDS.maxX);
+			MotionKernels::IntegrateWrap(bulletY.data(), bulletVelocityY.data(), stepScale, fired, BOUNDS.minY, BOUNDS.maxY);
+			for (unsigned int index = 0; index < NUM_TARGETS; ++index)
+			{
+				collision.UpdateColliderPosition(targets[index], XMFLOAT3(targetX[index], targetY[index], 0.0f));
+			}
+			for (unsigned int index = 0; index < fired; ++index)
+			{
+				collision.UpdateColliderPosition(bullets[index], XMFLOAT3(bulletX[index], bulletY[index], 0.0f));
+			}
+
+			collision.FindContacts();
+			unsigned int count = 0;
+			const Contact *contacts = collision.GetContacts(CONTACT_BULLET_ASTEROID, &count);
+			for (unsigned int contact = 0; contact < count; ++contact)
+			{
+				unsigned int bullet = contacts[contact].first.GetEntityHandle().index;
+				if (bulletAge[bullet] < 0)
+					continue;
+
+				++hits;
+				bulletAge[bullet] = -1;
+				collision.DestroyCollider(bullets[bullet]);
+			}
+
+			for (unsigned int index = 0; index < fired; ++index)
+			{
+				if (bulletAge[index] >= 0 && ++bulletAge[index] == lifeTicks)
+				{
+					bulletAge[index] = -1;
+					collision.DestroyCollider(bullets[index]);
+				}
+			}
+			collision.ApplyPendingChanges();
+		}
+
+		return hits;
+	}
+
+	int CheckTickRates(const Options &baseOptions)
+	{
+		const int tickRates[] = { 60, 30, 20, 15, 10 };
+		const int numTickRates = sizeof(tickRates) / sizeof(tickRates[0]);
+		const float IDLE_SECONDS = 4.0f;
+		const float POSITION_TOLERANCE = 0.05f;
+		const float WIDTH = 800.0f;
+		const float HEIGHT = 600.0f;
+		int failures = 0;
+
+		// The same asteroid field, moved by ticks of different lengths
+		std::vector<float> referenceX, referenceY, positionsX, positionsY;
+		RunIdle(baseOptions, static_cast<float>(tickRates[0]), IDLE_SECONDS, &referenceX, &referenceY);
+		for (int rate = 1; rate < numTickRates; ++rate)
+		{
+			RunIdle(baseOptions, static_cast<float>(tickRates[rate]), IDLE_SECONDS, &positionsX, &positionsY);
+			float worst = 0.0f;
+			bool sameCount = positionsX.size() == referenceX.size();
+			for (unsigned int index = 0; sameCount && index < referenceX.size(); ++index)
+			{
+				float dx = MotionKernels::WrapDelta(positionsX[index] - referenceX[index], WIDTH, 1.0f / WIDTH);
+				float dy = MotionKernels::WrapDelta(positionsY[index] - referenceY[index], HEIGHT, 1.0f / HEIGHT);
+				worst = std::max(worst, std::sqrt(dx * dx + dy * dy));
+			}
+
+			bool same = sameCount && worst <= POSITION_TOLERANCE;
+			printf("idle %dHz: asteroids=%u drift=%.5f%s\n", tickRates[rate],
+				static_cast<unsigned int>(positionsX.size()), worst, same ? "" : " MISMATCH");
+			if (!same)
+				++failures;
+		}
+
+		// Hits with and without sweeps; only swept ones have to match
+		unsigned int referenceHits = RunGallery(baseOptions.seed, tickRates[0], true);
+		for (int rate = 0; rate < numTickRates; ++rate)
+		{
+			unsigned int hits = RunGallery(baseOptions.seed, tickRates[rate], true);
+			unsigned int unsweptHits = RunGallery(baseOptions.seed, tickRates[rate], false);
+			printf("gallery %dHz: hits=%u unswept=%u%s\n", tickRates[rate], hits, unsweptHits,
+				hits == referenceHits ? "" : " MISMATCH");
+			if (hits != referenceHits)
+				++failures;
+		}
+
+		// What each rate costs for the same stretch of play; reported, not checked
+		for (int rate = 0; rate < numTickRates; ++rate)
+		{
+			Options options = baseOptions;
+			options.tickRate = static_cast<float>(tickRates[rate]);
+			options.ticks = baseOptions.ticks * tickRates[rate] / tickRates[0];
+			RunResult result = Run(options);
+			float seconds = result.ticks / options.tickRate;
+			printf("play %dHz: seconds=%.2f ms=%.1f ms/s=%.2f\n", tickRates[rate],
+				seconds, result.milliseconds, result.milliseconds / seconds);
+		}
+
+		printf("%s\n", failures == 0 ? "tick rate independent" : "NOT tick rate independent");
+		return failures == 0 ? 0 : 1;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, &options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	if (options.checkDeterminism)
+		return CheckDeterminism(options);
+	if (options.checkTickRates)
+		return CheckTickRates(options);
+
+	PrintResult(Run(options));
+	return 0;
+}
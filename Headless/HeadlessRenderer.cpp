@@ -0,0 +1,249 @@
+#include "Game.h"
+#include "Ship.h"
+#include "UFO.h"
+#include "Graphics.h"
+#include "GameRenderer.h"
+#include "Background.h"
+#include "RecordingRenderDevice.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Plays the game as HeadlessSimulation does and draws every frame with
+// GameRenderer into a RecordingRenderDevice, with no window or GPU. Each
+// frame's draw calls and vertex counts are checked against what the game
+// holds: one immediate mode draw per topology in use, one text draw per font
+// in use, and the vertices every entity, particle and character should add.
+// The game starts again whenever it ends. Fails on the first frame that
+// differs, otherwise prints the time spent building frames.
+namespace
+{
+	struct FrameCounts
+	{
+		FrameCounts() :
+			points(0),
+			lines(0),
+			immediateDraws(0),
+			textVertices(0),
+			textDraws(0)
+		{
+		}
+
+		unsigned int points;
+		unsigned int lines;
+		unsigned int immediateDraws;
+		unsigned int textVertices;
+		unsigned int textDraws;
+	};
+
+	unsigned int CountTextVertices(const std::string &text)
+	{
+		unsigned int glyphs = 0;
+		for (std::string::const_iterator characterIt = text.begin(), end = text.end();
+			characterIt != end;
+			++characterIt)
+		{
+			if (*characterIt != ' ')
+				++glyphs;
+		}
+		return glyphs * 6;
+	}
+
+	unsigned int CountShipLines(const Ship *ship)
+	{
+		return dynamic_cast<const UFO *>(ship) ? 14 : 8;
+	}
+
+	unsigned int CountShipPoints(const Ship *ship)
+	{
+		if (dynamic_cast<const UFO *>(ship) || !ship->IsThrusting())
+			return 0;
+
+		return PatternBank::EXHAUST_POINTS;
+	}
+
+	// What GameRenderer::RenderEverything should send, with line strips
+	// batched as lists
+	FrameCounts GetExpectedCounts(const Game &game, std::vector<float> *scratchX, std::vector<float> *scratchY)
+	{
+		FrameCounts counts;
+		counts.points = Background::NUM_STARS;
+
+		const Ship *player = game.GetPlayer();
+		const Ship *enemy = game.GetEnemy();
+		if (player)
+		{
+			counts.points += CountShipPoints(player);
+			counts.lines += CountShipLines(player);
+		}
+		if (enemy)
+		{
+			counts.points += CountShipPoints(enemy);
+			counts.lines += CountShipLines(enemy);
+		}
+
+		const World &world = game.GetWorld();
+		counts.lines += world.asteroids.Size() * 8;
+		for (unsigned int index = 0; index < world.bullets.Size(); ++index)
+		{
+			counts.lines += (world.bullets.owner[index] == Enemy) ? 6 : 8;
+		}
+
+		const SimClock &clock = game.GetClock();
+		double renderTime = clock.GetTime() - (1.0 - game.GetInterpolationAlpha()) * clock.GetTickSeconds();
+		unsigned int maxAnalytic = world.particles.GetMaxAnalyticParticles();
+		scratchX->resize(maxAnalytic);
+		scratchY->resize(maxAnalytic);
+		counts.points += world.particles.EvaluateAnalytic(renderTime, scratchX->data(), scratchY->data(), maxAnalytic);
+
+		counts.immediateDraws = (counts.points > 0 ? 1 : 0) + (counts.lines > 0 ? 1 : 0);
+
+		unsigned int mediumVertices = CountTextVertices("Score: " + std::to_string(game.GetScore()));
+		if (player)
+			mediumVertices += CountTextVertices("Lives: " + std::to_string(player->GetNumLives()));
+
+		unsigned int smallVertices = 0;
+		const std::vector<Game::Score> &popups = game.GetPopups();
+		for (std::vector<Game::Score>::const_iterator popupIt = popups.begin(), end = popups.end();
+			popupIt != end;
+			++popupIt)
+		{
+			smallVertices += CountTextVertices("+" + std::to_string(popupIt->value));
+		}
+
+		counts.textVertices = mediumVertices + smallVertices;
+		counts.textDraws = (mediumVertices > 0 ? 1 : 0) + (smallVertices > 0 ? 1 : 0);
+		return counts;
+	}
+
+	FrameCounts GetRecordedCounts(const RecordingRenderDevice &device)
+	{
+		FrameCounts counts;
+		const std::vector<RecordingRenderDevice::DrawCall> &drawCalls = device.GetDrawCalls();
+		for (std::vector<RecordingRenderDevice::DrawCall>::const_iterator drawIt = drawCalls.begin(), end = drawCalls.end();
+			drawIt != end;
+			++drawIt)
+		{
+			if (drawIt->pipeline == RENDER_PIPELINE_SPRITE_FONT)
+			{
+				++counts.textDraws;
+				counts.textVertices += drawIt->vertexCount;
+				continue;
+			}
+
+			++counts.immediateDraws;
+			if (drawIt->topology == RENDER_TOPOLOGY_POINT_LIST)
+				counts.points += drawIt->vertexCount;
+			else if (drawIt->topology == RENDER_TOPOLOGY_LINE_LIST)
+				counts.lines += drawIt->vertexCount;
+		}
+		return counts;
+	}
+
+	bool Matches(const FrameCounts &expected, const FrameCounts &recorded, const RecordingRenderDevice &device)
+	{
+		return expected.points == recorded.points &&
+			expected.lines == recorded.lines &&
+			expected.immediateDraws == recorded.immediateDraws &&
+			expected.textVertices == recorded.textVertices &&
+			expected.textDraws == recorded.textDraws &&
+			device.GetVertexCount(RENDER_PIPELINE_IMMEDIATE_MODE) == recorded.points + recorded.lines &&
+			device.GetVertexCount(RENDER_PIPELINE_SPRITE_FONT) == recorded.textVertices &&
+			device.GetClearCount() == 1;
+	}
+
+	void PrintCounts(const char *name, const FrameCounts &counts)
+	{
+		printf("  %s: points=%u lines=%u draws=%u text=%u textDraws=%u\n",
+			name,
+			counts.points,
+			counts.lines,
+			counts.immediateDraws,
+			counts.textVertices,
+			counts.textDraws);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int frames = 600;
+	int level = 5;
+	uint64_t seed = Random::DEFAULT_SEED;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--frames") == 0)
+			frames = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--level") == 0)
+			level = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--seed") == 0)
+			seed = strtoull(argv[i + 1], 0, 10);
+		else
+		{
+			printf("Usage: HeadlessRenderer [--frames N] [--level N] [--seed N]\n");
+			return 1;
+		}
+	}
+
+	RecordingRenderDevice device;
+	Graphics *graphics = Graphics::CreateDevice(&device);
+	GameRenderer renderer;
+
+	Game *game = new Game();
+	game->SetRandomSeed(seed);
+	game->InitialiseLevel(level);
+
+	GameInput input;
+	input.fire = true;
+	input.rotation = 1.0f;
+	input.acceleration = 0.5f;
+	input.fireMode = GameInput::FIRE_MODE_SCATTER;
+
+	// Frames a little longer than ticks, so they land between them
+	const double FRAME_SECONDS = 1.0 / 50.0;
+
+	std::vector<float> scratchX;
+	std::vector<float> scratchY;
+	double milliseconds = 0.0;
+	bool ok = true;
+	int frame = 0;
+	for (; frame < frames; ++frame)
+	{
+		game->Advance(FRAME_SECONDS, input);
+		input.fireMode = GameInput::FIRE_MODE_UNCHANGED;
+		if (game->IsGameOver() || game->IsLevelComplete())
+		{
+			game->ResetGame();
+			game->InitialiseLevel(level);
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		graphics->BeginFrame();
+		renderer.RenderEverything(graphics, game);
+		graphics->EndFrame();
+		milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		FrameCounts expected = GetExpectedCounts(*game, &scratchX, &scratchY);
+		FrameCounts recorded = GetRecordedCounts(device);
+		if (!Matches(expected, recorded, device))
+		{
+			printf("FAILED on frame %d (clears=%u)\n", frame, device.GetClearCount());
+			PrintCounts("expected", expected);
+			PrintCounts("recorded", recorded);
+			ok = false;
+			break;
+		}
+	}
+
+	printf("frames=%d draws=%llu vertices=%llu frame=%.3fms\n",
+		frame,
+		static_cast<unsigned long long>(device.GetTotalDrawCalls()),
+		static_cast<unsigned long long>(device.GetTotalVertices()),
+		frame > 0 ? milliseconds / frame : 0.0);
+
+	delete game;
+	Graphics::DestroyDevice(graphics);
+	return ok ? 0 : 1;
+}
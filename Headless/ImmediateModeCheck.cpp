@@ -0,0 +1,330 @@
+#include "ImmediateMode.h"
+#include "RecordingRenderDevice.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Builds frames of random draws through ImmediateMode into a
+// RecordingRenderDevice, with a fixed seed so any failure replays, and
+// checks every recorded vertex against its model matrix applied by hand.
+// Draws use every topology, with strips long and short enough to be
+// dropped, and model matrices that are identity, moves or scaled and
+// rotated, the way GameRenderer's are. Changing the view part way through
+// checks that the batches so far go out first. A zigzag triangle strip
+// checks that turning strips into lists keeps every triangle wound the
+// same way.
+namespace
+{
+	const float POSITION_TOLERANCE = 1e-5f;
+
+	struct ExpectedDraw
+	{
+		RenderTopology topology;
+		XMFLOAT4X4 view;
+		std::vector<ImmediateModeVertex> vertices;
+	};
+
+	struct ExpectedFrame
+	{
+		std::vector<ImmediateModeVertex> batches[RENDER_TOPOLOGY_COUNT];
+		std::vector<ExpectedDraw> draws;
+	};
+
+	// Row vectors, as DirectXMath has them
+	ImmediateModeVertex Transform(const XMFLOAT4X4 &model, const ImmediateModeVertex &vertex)
+	{
+		ImmediateModeVertex transformed;
+		transformed.x = vertex.x * model.m[0][0] + vertex.y * model.m[1][0] + vertex.z * model.m[2][0] + model.m[3][0];
+		transformed.y = vertex.x * model.m[0][1] + vertex.y * model.m[1][1] + vertex.z * model.m[2][1] + model.m[3][1];
+		transformed.z = vertex.x * model.m[0][2] + vertex.y * model.m[1][2] + vertex.z * model.m[2][2] + model.m[3][2];
+		transformed.diffuse = vertex.diffuse;
+		return transformed;
+	}
+
+	// What ImmediateMode::Draw should add to the batches
+	void AddExpected(ExpectedFrame *frame, RenderTopology topology, const XMFLOAT4X4 &model,
+		const std::vector<ImmediateModeVertex> &vertices)
+	{
+		std::vector<ImmediateModeVertex> transformed;
+		for (std::vector<ImmediateModeVertex>::const_iterator vertexIt = vertices.begin(), end = vertices.end();
+			vertexIt != end;
+			++vertexIt)
+		{
+			transformed.push_back(Transform(model, *vertexIt));
+		}
+
+		unsigned int count = static_cast<unsigned int>(transformed.size());
+		if (topology == RENDER_TOPOLOGY_LINE_STRIP)
+		{
+			std::vector<ImmediateModeVertex> &batch = frame->batches[RENDER_TOPOLOGY_LINE_LIST];
+			for (unsigned int i = 1; i < count; ++i)
+			{
+				batch.push_back(transformed[i - 1]);
+				batch.push_back(transformed[i]);
+			}
+		}
+		else if (topology == RENDER_TOPOLOGY_TRIANGLE_STRIP)
+		{
+			// Odd triangles have their first two corners swapped
+			std::vector<ImmediateModeVertex> &batch = frame->batches[RENDER_TOPOLOGY_TRIANGLE_LIST];
+			for (unsigned int i = 2; i < count; ++i)
+			{
+				bool odd = (i % 2) == 1;
+				batch.push_back(transformed[odd ? i - 1 : i - 2]);
+				batch.push_back(transformed[odd ? i - 2 : i - 1]);
+				batch.push_back(transformed[i]);
+			}
+		}
+		else
+		{
+			std::vector<ImmediateModeVertex> &batch = frame->batches[topology];
+			batch.insert(batch.end(), transformed.begin(), transformed.end());
+		}
+	}
+
+	void FlushExpected(ExpectedFrame *frame, const XMFLOAT4X4 &view)
+	{
+		for (int topology = 0; topology < RENDER_TOPOLOGY_COUNT; ++topology)
+		{
+			if (frame->batches[topology].empty())
+				continue;
+
+			ExpectedDraw draw;
+			draw.topology = static_cast<RenderTopology>(topology);
+			draw.view = view;
+			draw.vertices.swap(frame->batches[topology]);
+			frame->draws.push_back(draw);
+		}
+	}
+
+	XMMATRIX GetRandomModel(Random &random)
+	{
+		XMMATRIX translation = XMMatrixTranslation(random.NextFloat(-400.0f, 400.0f), random.NextFloat(-300.0f, 300.0f), 0.0f);
+		switch (random.NextUint() % 4)
+		{
+		case 0:
+			return XMMatrixIdentity();
+
+		case 1:
+			return translation;
+
+		case 2:
+			return XMMatrixRotationZ(random.NextFloat(-3.2f, 3.2f)) * translation;
+
+		default:
+		{
+			float scale = random.NextFloat(0.5f, 20.0f);
+			XMVECTOR axis = XMVector3Normalize(XMVectorSet(random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f), 1.0f, 0.0f));
+			return XMMatrixScaling(scale, scale, scale) * XMMatrixRotationAxis(axis, random.NextFloat(-3.2f, 3.2f)) * translation;
+		}
+		}
+	}
+
+	bool IsClose(float value, float expected)
+	{
+		return std::fabs(value - expected) <= POSITION_TOLERANCE * std::max(1.0f, std::fabs(expected));
+	}
+
+	bool IsIdentity(const XMFLOAT4X4 &matrix)
+	{
+		XMFLOAT4X4 identity;
+		XMStoreFloat4x4(&identity, XMMatrixIdentity());
+		return memcmp(&matrix, &identity, sizeof(identity)) == 0;
+	}
+
+	bool CheckRecorded(const ExpectedFrame &expected, const RecordingRenderDevice &device, int frame)
+	{
+		const std::vector<RecordingRenderDevice::DrawCall> &drawCalls = device.GetDrawCalls();
+		if (drawCalls.size() != expected.draws.size())
+		{
+			printf("FAILED: frame %d has %u draws, expected %u\n", frame,
+				static_cast<unsigned int>(drawCalls.size()), static_cast<unsigned int>(expected.draws.size()));
+			return false;
+		}
+
+		const ImmediateModeVertex *stream = reinterpret_cast<const ImmediateModeVertex *>(
+			device.GetVertexStream(RENDER_PIPELINE_IMMEDIATE_MODE));
+		for (unsigned int drawIndex = 0; drawIndex < drawCalls.size(); ++drawIndex)
+		{
+			const RecordingRenderDevice::DrawCall &drawCall = drawCalls[drawIndex];
+			const ExpectedDraw &draw = expected.draws[drawIndex];
+			if (drawCall.pipeline != RENDER_PIPELINE_IMMEDIATE_MODE ||
+				drawCall.topology != draw.topology ||
+				drawCall.vertexCount != draw.vertices.size() ||
+				!IsIdentity(drawCall.matrices.model) ||
+				memcmp(&drawCall.matrices.view, &draw.view, sizeof(draw.view)) != 0)
+			{
+				printf("FAILED: frame %d draw %u is topology %d with %u vertices, expected topology %d with %u\n",
+					frame, drawIndex, static_cast<int>(drawCall.topology), drawCall.vertexCount,
+					static_cast<int>(draw.topology), static_cast<unsigned int>(draw.vertices.size()));
+				return false;
+			}
+
+			const ImmediateModeVertex *recorded = stream + drawCall.firstVertex;
+			for (unsigned int index = 0; index < drawCall.vertexCount; ++index)
+			{
+				const ImmediateModeVertex &vertex = draw.vertices[index];
+				if (!IsClose(recorded[index].x, vertex.x) ||
+					!IsClose(recorded[index].y, vertex.y) ||
+					!IsClose(recorded[index].z, vertex.z) ||
+					recorded[index].diffuse != vertex.diffuse)
+				{
+					printf("FAILED: frame %d draw %u vertex %u is (%.6g, %.6g, %.6g), expected (%.6g, %.6g, %.6g)\n",
+						frame, drawIndex, index,
+						recorded[index].x, recorded[index].y, recorded[index].z,
+						vertex.x, vertex.y, vertex.z);
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool CheckFrame(ImmediateMode *mode, RecordingRenderDevice &device, Random &random, int frame, int drawsPerFrame)
+	{
+		const unsigned int MAX_VERTICES = 12;
+
+		ExpectedFrame expected;
+		XMFLOAT4X4 view;
+		XMStoreFloat4x4(&view, XMMatrixIdentity());
+
+		device.BeginFrame();
+		mode->BeginFrame();
+		mode->SetViewMatrix(XMMatrixIdentity());
+
+		std::vector<ImmediateModeVertex> vertices;
+		for (int draw = 0; draw < drawsPerFrame; ++draw)
+		{
+			if (random.NextUint() % 32 == 0)
+			{
+				XMMATRIX newView = XMMatrixTranslation(random.NextFloat(-50.0f, 50.0f), random.NextFloat(-50.0f, 50.0f), 0.0f);
+				FlushExpected(&expected, view);
+				XMStoreFloat4x4(&view, newView);
+				mode->SetViewMatrix(newView);
+			}
+
+			RenderTopology topology = static_cast<RenderTopology>(random.NextUint() % RENDER_TOPOLOGY_COUNT);
+			vertices.resize(random.NextUint() % (MAX_VERTICES + 1));
+			for (std::vector<ImmediateModeVertex>::iterator vertexIt = vertices.begin(), end = vertices.end();
+				vertexIt != end;
+				++vertexIt)
+			{
+				vertexIt->x = random.NextFloat(-20.0f, 20.0f);
+				vertexIt->y = random.NextFloat(-20.0f, 20.0f);
+				vertexIt->z = 0.0f;
+				vertexIt->diffuse = random.NextUint();
+			}
+
+			XMMATRIX model = GetRandomModel(random);
+			XMFLOAT4X4 storedModel;
+			XMStoreFloat4x4(&storedModel, model);
+			AddExpected(&expected, topology, storedModel, vertices);
+
+			mode->SetModelMatrix(model);
+			mode->Draw(topology, vertices.data(), static_cast<unsigned int>(vertices.size()));
+		}
+		mode->SetModelMatrix(XMMatrixIdentity());
+
+		FlushExpected(&expected, view);
+		mode->EndFrame();
+		device.EndFrame();
+
+		return CheckRecorded(expected, device, frame);
+	}
+
+	float GetSignedArea(const ImmediateModeVertex *triangle)
+	{
+		return (triangle[1].x - triangle[0].x) * (triangle[2].y - triangle[0].y) -
+			(triangle[2].x - triangle[0].x) * (triangle[1].y - triangle[0].y);
+	}
+
+	// Zigzagging between two rows, so every triangle of the strip faces the
+	// same way
+	bool CheckStripWinding(ImmediateMode *mode, RecordingRenderDevice &device)
+	{
+		const unsigned int STRIP_VERTICES = 9;
+
+		ImmediateModeVertex strip[STRIP_VERTICES];
+		for (unsigned int i = 0; i < STRIP_VERTICES; ++i)
+		{
+			strip[i].x = static_cast<float>(i / 2) * 10.0f;
+			strip[i].y = (i % 2) * 10.0f;
+			strip[i].z = 0.0f;
+			strip[i].diffuse = 0xffffffff;
+		}
+
+		device.BeginFrame();
+		mode->BeginFrame();
+		mode->SetViewMatrix(XMMatrixIdentity());
+		mode->SetModelMatrix(XMMatrixScaling(2.0f, 2.0f, 2.0f) * XMMatrixRotationZ(0.7f) * XMMatrixTranslation(100.0f, -50.0f, 0.0f));
+		mode->Draw(RENDER_TOPOLOGY_TRIANGLE_STRIP, strip, STRIP_VERTICES);
+		mode->SetModelMatrix(XMMatrixIdentity());
+		mode->EndFrame();
+		device.EndFrame();
+
+		const std::vector<RecordingRenderDevice::DrawCall> &drawCalls = device.GetDrawCalls();
+		if (drawCalls.size() != 1 ||
+			drawCalls[0].topology != RENDER_TOPOLOGY_TRIANGLE_LIST ||
+			drawCalls[0].vertexCount != (STRIP_VERTICES - 2) * 3)
+		{
+			printf("FAILED: a strip of %u is not %u triangles in one list\n", STRIP_VERTICES, STRIP_VERTICES - 2);
+			return false;
+		}
+
+		const ImmediateModeVertex *triangles = reinterpret_cast<const ImmediateModeVertex *>(
+			device.GetVertexStream(RENDER_PIPELINE_IMMEDIATE_MODE));
+		float firstArea = GetSignedArea(triangles);
+		for (unsigned int triangle = 1; triangle < STRIP_VERTICES - 2; ++triangle)
+		{
+			if ((GetSignedArea(triangles + triangle * 3) > 0.0f) != (firstArea > 0.0f))
+			{
+				printf("FAILED: strip triangle %u is wound the other way to the first\n", triangle);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int frames = 20;
+	int draws = 400;
+	uint64_t seed = Random::DEFAULT_SEED;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--frames") == 0)
+			frames = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--draws") == 0)
+			draws = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--seed") == 0)
+			seed = strtoull(argv[i + 1], 0, 10);
+		else
+		{
+			printf("Usage: ImmediateModeCheck [--frames N] [--draws N] [--seed N]\n");
+			return 1;
+		}
+	}
+
+	RecordingRenderDevice device;
+	ImmediateMode *mode = ImmediateMode::CreateImmediateMode(&device);
+
+	bool ok = CheckStripWinding(mode, device);
+
+	Random random(seed);
+	int frame = 0;
+	for (; ok && frame < frames; ++frame)
+	{
+		ok = CheckFrame(mode, device, random, frame, draws);
+	}
+
+	printf("%s: frames=%d vertices=%llu\n", ok ? "ok" : "FAILED", frame,
+		static_cast<unsigned long long>(device.GetTotalVertices()));
+
+	ImmediateMode::DestroyImmediateMode(mode);
+	return ok ? 0 : 1;
+}
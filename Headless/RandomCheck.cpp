@@ -0,0 +1,180 @@
+#include "Random.h"
+#include "MotionKernels.h"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+// Checks that Random replays the same on every platform: its first outputs
+// and those after Jump() against the reference xoshiro128+ with its state
+// seeded by SplitMix64, that streams from Split() share no run of outputs
+// over a long prefix, and that Fill() gives the same floats as drawing them
+// one at a time, on the scalar path and the widest SIMD one.
+namespace
+{
+	const unsigned int NUM_REFERENCE = 8;
+
+	struct Reference
+	{
+		uint64_t seed;
+		uint32_t first[NUM_REFERENCE];
+		uint32_t jumped[NUM_REFERENCE];
+	};
+
+	// From the reference C code by Blackman and Vigna, with the two 64 bit
+	// SplitMix64 outputs laid into the state low word first
+	const Reference REFERENCES[] =
+	{
+		{
+			1,
+			{ 0x47edea62U, 0xb3e6660bU, 0xfe08b43dU, 0x6f8bca7dU, 0x4ac7256cU, 0xf5399113U, 0xef73dc2bU, 0x1dc4e072U },
+			{ 0xa5b34e8cU, 0x86a22edaU, 0xd052ea37U, 0x3029fa45U, 0x4c60fb3bU, 0xefb082faU, 0x041dc901U, 0x95b61651U },
+		},
+		{
+			12345,
+			{ 0xde3fee85U, 0xbaa437d0U, 0x6da600ecU, 0xe57a2a24U, 0x94388ac2U, 0x2e282281U, 0xaad4bcf3U, 0xaa3c79b6U },
+			{ 0x79236e02U, 0xb6c4b262U, 0x8648516fU, 0x889b13fdU, 0x2237946eU, 0x9aeee68dU, 0xc6e4dd75U, 0x76131b08U },
+		},
+	};
+
+	bool MatchesReference(Random random, const uint32_t *expected, const char *name, uint64_t seed)
+	{
+		for (unsigned int index = 0; index < NUM_REFERENCE; ++index)
+		{
+			uint32_t value = random.NextUint();
+			if (value != expected[index])
+			{
+				printf("FAILED: seed %llu %s output %u is 0x%08x, expected 0x%08x\n",
+					static_cast<unsigned long long>(seed), name, index, value, expected[index]);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool CheckReference()
+	{
+		bool ok = true;
+		for (unsigned int reference = 0; reference < sizeof(REFERENCES) / sizeof(REFERENCES[0]); ++reference)
+		{
+			const Reference &expected = REFERENCES[reference];
+			Random random(expected.seed);
+			ok = MatchesReference(random, expected.first, "first", expected.seed) && ok;
+
+			random.Jump();
+			ok = MatchesReference(random, expected.jumped, "jumped", expected.seed) && ok;
+		}
+		return ok;
+	}
+
+	// Every pair of neighbouring outputs as one key, so a stream that ran
+	// into another would share keys with it
+	void GetPairKeys(Random random, unsigned int count, std::vector<uint64_t> *keys)
+	{
+		keys->clear();
+		uint64_t previous = random.NextUint();
+		for (unsigned int index = 1; index < count; ++index)
+		{
+			uint64_t next = random.NextUint();
+			keys->push_back((previous << 32) | next);
+			previous = next;
+		}
+		std::sort(keys->begin(), keys->end());
+	}
+
+	bool CheckSplit()
+	{
+		const unsigned int NUM_STREAMS = 8;
+		const unsigned int PREFIX = 1 << 16;
+
+		Random parent(Random::DEFAULT_SEED);
+		Random before = parent;
+		std::vector<Random> streams;
+		for (unsigned int stream = 0; stream < NUM_STREAMS; ++stream)
+		{
+			streams.push_back(parent.Split());
+		}
+		streams.push_back(parent);
+
+		// The first split hands out the parent as it was
+		if (streams[0].NextUint() != before.NextUint())
+		{
+			printf("FAILED: Split() does not return the stream as it was\n");
+			return false;
+		}
+
+		std::vector<std::vector<uint64_t> > keys(streams.size());
+		for (unsigned int stream = 0; stream < streams.size(); ++stream)
+		{
+			GetPairKeys(streams[stream], PREFIX, &keys[stream]);
+		}
+
+		bool ok = true;
+		std::vector<uint64_t> shared;
+		for (unsigned int a = 0; a < keys.size(); ++a)
+		{
+			for (unsigned int b = a + 1; b < keys.size(); ++b)
+			{
+				shared.clear();
+				std::set_intersection(keys[a].begin(), keys[a].end(), keys[b].begin(), keys[b].end(),
+					std::back_inserter(shared));
+				if (!shared.empty())
+				{
+					printf("FAILED: streams %u and %u overlap within %u outputs\n", a, b, PREFIX);
+					ok = false;
+				}
+			}
+		}
+		return ok;
+	}
+
+	bool CheckFill(MotionKernels::Path path)
+	{
+		// Either side of the SIMD width and of Fill's blocks
+		const unsigned int COUNTS[] = { 1, 3, 4, 5, 63, 64, 65, 129, 1000 };
+		const float MIN = -300.0f;
+		const float MAX = 400.0f;
+
+		MotionKernels::SetPath(path);
+		bool ok = true;
+		std::vector<float> filled;
+		for (unsigned int countIndex = 0; countIndex < sizeof(COUNTS) / sizeof(COUNTS[0]); ++countIndex)
+		{
+			unsigned int count = COUNTS[countIndex];
+			filled.resize(count);
+
+			// Fill a copy of this thread's generator, then draw the same
+			// values from the generator itself
+			Random copy = Random::GetThreadGenerator();
+			copy.Fill(filled.data(), count, MIN, MAX);
+			for (unsigned int index = 0; index < count; ++index)
+			{
+				float drawn = Random::GetFloat(MIN, MAX);
+				if (filled[index] != drawn)
+				{
+					printf("FAILED: path %d Fill of %u gives %.9g at %u, GetFloat %.9g\n",
+						static_cast<int>(path), count, filled[index], index, drawn);
+					ok = false;
+					break;
+				}
+			}
+		}
+		return ok;
+	}
+}
+
+int main()
+{
+	bool ok = CheckReference();
+	ok = CheckSplit() && ok;
+
+	MotionKernels::Path bestPath = MotionKernels::GetBestSupportedPath();
+	ok = CheckFill(MotionKernels::PATH_SCALAR) && ok;
+	if (bestPath != MotionKernels::PATH_SCALAR)
+		ok = CheckFill(bestPath) && ok;
+	MotionKernels::SetPath(bestPath);
+
+	printf("%s (fill paths: scalar%s)\n", ok ? "ok" : "FAILED",
+		bestPath != MotionKernels::PATH_SCALAR ? ", simd" : "");
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,413 @@
+#include "AabbTree.h"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	struct BoxQuery
+	{
+		const Aabb *box;
+		std::vector<unsigned int> *objectIds;
+
+		bool Enter(const Aabb &nodeBox) const { return nodeBox.Overlaps(*box); }
+		void Visit(unsigned int objectId) { objectIds->push_back(objectId); }
+	};
+
+	Aabb Combine(const Aabb &a, const Aabb &b)
+	{
+		Aabb box;
+		box.minX = std::min(a.minX, b.minX);
+		box.minY = std::min(a.minY, b.minY);
+		box.maxX = std::max(a.maxX, b.maxX);
+		box.maxY = std::max(a.maxY, b.maxY);
+		return box;
+	}
+
+	float Perimeter(const Aabb &box)
+	{
+		return 2.0f * ((box.maxX - box.minX) + (box.maxY - box.minY));
+	}
+
+	Aabb Fatten(const Aabb &box, float margin)
+	{
+		Aabb fat;
+		fat.minX = box.minX - margin;
+		fat.minY = box.minY - margin;
+		fat.maxX = box.maxX + margin;
+		fat.maxY = box.maxY + margin;
+		return fat;
+	}
+}
+
+AabbTree::AabbTree() :
+	root_(NULL_NODE),
+	numLeaves_(0)
+{
+}
+
+void AabbTree::Insert(unsigned int objectId, const Aabb &box, float margin,
+	CollisionMask layerBit, CollisionMask mask)
+{
+	if (leafOf_.size() <= objectId)
+	{
+		leafOf_.resize(objectId + 1, NULL_NODE);
+	}
+	assert(leafOf_[objectId] == NULL_NODE);
+
+	int leaf = AllocateNode();
+	Node &node = nodes_[leaf];
+	node.box = Fatten(box, margin);
+	node.objectId = objectId;
+	node.height = 0;
+	node.layerBits = layerBit;
+	node.masks = mask;
+
+	leafOf_[objectId] = leaf;
+	++numLeaves_;
+	InsertLeaf(leaf);
+}
+
+void AabbTree::Remove(unsigned int objectId)
+{
+	if (!Contains(objectId))
+		return;
+
+	int leaf = leafOf_[objectId];
+	RemoveLeaf(leaf);
+	FreeNode(leaf);
+	leafOf_[objectId] = NULL_NODE;
+	--numLeaves_;
+}
+
+bool AabbTree::Move(unsigned int objectId, const Aabb &box, float margin,
+	CollisionMask layerBit, CollisionMask mask)
+{
+	if (!Contains(objectId))
+	{
+		Insert(objectId, box, margin, layerBit, mask);
+		return true;
+	}
+
+	int leaf = leafOf_[objectId];
+	Node &node = nodes_[leaf];
+	if (node.box.Contains(box))
+	{
+		if (node.layerBits != layerBit || node.masks != mask)
+		{
+			node.layerBits = layerBit;
+			node.masks = mask;
+			for (int parent = node.parent; parent != NULL_NODE; parent = nodes_[parent].parent)
+			{
+				CombineChildren(parent);
+			}
+		}
+		return false;
+	}
+
+	RemoveLeaf(leaf);
+	node.box = Fatten(box, margin);
+	node.layerBits = layerBit;
+	node.masks = mask;
+	InsertLeaf(leaf);
+	return true;
+}
+
+bool AabbTree::Contains(unsigned int objectId) const
+{
+	return objectId < leafOf_.size() && leafOf_[objectId] != NULL_NODE;
+}
+
+void AabbTree::Clear()
+{
+	nodes_.clear();
+	freeNodes_.clear();
+	leafOf_.clear();
+	root_ = NULL_NODE;
+	numLeaves_ = 0;
+}
+
+void AabbTree::Query(const Aabb &box, CollisionMask mask, std::vector<unsigned int> *objectIds) const
+{
+	BoxQuery query;
+	query.box = &box;
+	query.objectIds = objectIds;
+	Traverse(mask, query);
+}
+
+void AabbTree::QueryPairs(std::vector<IdPair> *pairs)
+{
+	if (root_ == NULL_NODE)
+		return;
+
+	// Node pairs share the id pair type; a node paired with itself stands
+	// for every pair inside its subtree
+	pairStack_.clear();
+	pairStack_.push_back(IdPair(root_, root_));
+
+	while (!pairStack_.empty())
+	{
+		int nodeA = static_cast<int>(pairStack_.back().first);
+		int nodeB = static_cast<int>(pairStack_.back().second);
+		pairStack_.pop_back();
+
+		const Node &a = nodes_[nodeA];
+		const Node &b = nodes_[nodeB];
+
+		if (nodeA == nodeB)
+		{
+			if (!a.IsLeaf() && (a.masks & a.layerBits) != 0)
+			{
+				pairStack_.push_back(IdPair(a.child1, a.child1));
+				pairStack_.push_back(IdPair(a.child2, a.child2));
+				pairStack_.push_back(IdPair(a.child1, a.child2));
+			}
+			continue;
+		}
+
+		if ((a.masks & b.layerBits) == 0 || (b.masks & a.layerBits) == 0 || !a.box.Overlaps(b.box))
+			continue;
+
+		if (a.IsLeaf() && b.IsLeaf())
+		{
+			pairs->push_back(IdPair(std::min(a.objectId, b.objectId), std::max(a.objectId, b.objectId)));
+		}
+		else if (b.IsLeaf() || (!a.IsLeaf() && Perimeter(a.box) >= Perimeter(b.box)))
+		{
+			// Open up the bigger of the two
+			pairStack_.push_back(IdPair(a.child1, nodeB));
+			pairStack_.push_back(IdPair(a.child2, nodeB));
+		}
+		else
+		{
+			pairStack_.push_back(IdPair(nodeA, b.child1));
+			pairStack_.push_back(IdPair(nodeA, b.child2));
+		}
+	}
+}
+
+int AabbTree::GetHeight() const
+{
+	return root_ == NULL_NODE ? 0 : nodes_[root_].height;
+}
+
+unsigned int AabbTree::GetNumLeaves() const
+{
+	return numLeaves_;
+}
+
+int AabbTree::AllocateNode()
+{
+	int node;
+	if (freeNodes_.empty())
+	{
+		node = static_cast<int>(nodes_.size());
+		nodes_.push_back(Node());
+	}
+	else
+	{
+		node = freeNodes_.back();
+		freeNodes_.pop_back();
+	}
+
+	Node &allocated = nodes_[node];
+	allocated.parent = NULL_NODE;
+	allocated.child1 = NULL_NODE;
+	allocated.child2 = NULL_NODE;
+	allocated.height = 0;
+	allocated.objectId = 0;
+	allocated.layerBits = COLLISION_MASK_NONE;
+	allocated.masks = COLLISION_MASK_NONE;
+	return node;
+}
+
+void AabbTree::FreeNode(int node)
+{
+	nodes_[node].height = -1;
+	freeNodes_.push_back(node);
+}
+
+void AabbTree::InsertLeaf(int leaf)
+{
+	if (root_ == NULL_NODE)
+	{
+		root_ = leaf;
+		nodes_[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// Walk down to the sibling that costs least to pair the leaf with
+	Aabb leafBox = nodes_[leaf].box;
+	int index = root_;
+	while (!nodes_[index].IsLeaf())
+	{
+		const Node &node = nodes_[index];
+		float perimeter = Perimeter(node.box);
+		float combinedPerimeter = Perimeter(Combine(node.box, leafBox));
+
+		// Pairing with this node makes a new parent; going further down
+		// still pays for growing this node to fit the leaf
+		float cost = 2.0f * combinedPerimeter;
+		float inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+		float childCost[2];
+		int children[2] = { node.child1, node.child2 };
+		for (int child = 0; child < 2; ++child)
+		{
+			const Node &childNode = nodes_[children[child]];
+			float grown = Perimeter(Combine(childNode.box, leafBox));
+			if (childNode.IsLeaf())
+			{
+				childCost[child] = grown + inheritanceCost;
+			}
+			else
+			{
+				childCost[child] = (grown - Perimeter(childNode.box)) + inheritanceCost;
+			}
+		}
+
+		if (cost < childCost[0] && cost < childCost[1])
+			break;
+
+		index = childCost[0] < childCost[1] ? children[0] : children[1];
+	}
+
+	int sibling = index;
+	int oldParent = nodes_[sibling].parent;
+	int newParent = AllocateNode();
+	nodes_[newParent].parent = oldParent;
+	nodes_[newParent].height = nodes_[sibling].height + 1;
+	nodes_[newParent].child1 = sibling;
+	nodes_[newParent].child2 = leaf;
+	CombineChildren(newParent);
+	nodes_[sibling].parent = newParent;
+	nodes_[leaf].parent = newParent;
+
+	if (oldParent == NULL_NODE)
+	{
+		root_ = newParent;
+	}
+	else if (nodes_[oldParent].child1 == sibling)
+	{
+		nodes_[oldParent].child1 = newParent;
+	}
+	else
+	{
+		nodes_[oldParent].child2 = newParent;
+	}
+
+	Refit(nodes_[leaf].parent);
+}
+
+void AabbTree::RemoveLeaf(int leaf)
+{
+	if (leaf == root_)
+	{
+		root_ = NULL_NODE;
+		return;
+	}
+
+	// The sibling takes the parent's place
+	int parent = nodes_[leaf].parent;
+	int grandParent = nodes_[parent].parent;
+	int sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+	if (grandParent == NULL_NODE)
+	{
+		root_ = sibling;
+		nodes_[sibling].parent = NULL_NODE;
+	}
+	else
+	{
+		if (nodes_[grandParent].child1 == parent)
+		{
+			nodes_[grandParent].child1 = sibling;
+		}
+		else
+		{
+			nodes_[grandParent].child2 = sibling;
+		}
+		nodes_[sibling].parent = grandParent;
+		Refit(grandParent);
+	}
+
+	FreeNode(parent);
+}
+
+// Rebalances and recomputes bounds and heights from node up to the root
+void AabbTree::Refit(int node)
+{
+	while (node != NULL_NODE)
+	{
+		node = Balance(node);
+		CombineChildren(node);
+		node = nodes_[node].parent;
+	}
+}
+
+void AabbTree::CombineChildren(int node)
+{
+	Node &current = nodes_[node];
+	const Node &child1 = nodes_[current.child1];
+	const Node &child2 = nodes_[current.child2];
+	current.height = 1 + std::max(child1.height, child2.height);
+	current.box = Combine(child1.box, child2.box);
+	current.layerBits = child1.layerBits | child2.layerBits;
+	current.masks = child1.masks | child2.masks;
+}
+
+// If one child of a is more than one level taller than the other, rotates
+// it up into a's place. Returns whichever node now sits where a was.
+int AabbTree::Balance(int a)
+{
+	Node &nodeA = nodes_[a];
+	if (nodeA.IsLeaf() || nodeA.height < 2)
+		return a;
+
+	int b = nodeA.child1;
+	int c = nodeA.child2;
+	int balance = nodes_[c].height - nodes_[b].height;
+	if (balance >= -1 && balance <= 1)
+		return a;
+
+	// Rotate the taller child, up, and hand a the shorter grandchild
+	int up = balance > 1 ? c : b;
+	Node &nodeUp = nodes_[up];
+	int upChild1 = nodeUp.child1;
+	int upChild2 = nodeUp.child2;
+
+	nodeUp.child1 = a;
+	nodeUp.parent = nodeA.parent;
+	nodeA.parent = up;
+
+	if (nodeUp.parent == NULL_NODE)
+	{
+		root_ = up;
+	}
+	else if (nodes_[nodeUp.parent].child1 == a)
+	{
+		nodes_[nodeUp.parent].child1 = up;
+	}
+	else
+	{
+		nodes_[nodeUp.parent].child2 = up;
+	}
+
+	int taller = nodes_[upChild1].height > nodes_[upChild2].height ? upChild1 : upChild2;
+	int shorter = taller == upChild1 ? upChild2 : upChild1;
+
+	nodeUp.child2 = taller;
+	if (balance > 1)
+	{
+		nodeA.child2 = shorter;
+	}
+	else
+	{
+		nodeA.child1 = shorter;
+	}
+	nodes_[shorter].parent = a;
+
+	CombineChildren(a);
+	CombineChildren(up);
+
+	return up;
+}
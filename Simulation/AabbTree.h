@@ -0,0 +1,138 @@
+#ifndef AABBTREE_H_INCLUDED
+#define AABBTREE_H_INCLUDED
+
+#include <cassert>
+#include <utility>
+#include <vector>
+#include "CollisionLayer.h"
+
+struct Aabb
+{
+	float minX;
+	float minY;
+	float maxX;
+	float maxY;
+
+	bool Overlaps(const Aabb &other) const
+	{
+		return minX <= other.maxX && other.minX <= maxX &&
+			minY <= other.maxY && other.minY <= maxY;
+	}
+
+	bool Contains(const Aabb &other) const
+	{
+		return minX <= other.minX && other.maxX <= maxX &&
+			minY <= other.minY && other.maxY <= maxY;
+	}
+};
+
+// Dynamic bounding volume tree. Each leaf holds a fattened box around one
+// object so small movements leave the tree alone; when an object leaves its
+// box the leaf is taken out and put back in. Inserts choose the sibling that
+// grows the tree's total perimeter least, and the tree is kept balanced with
+// rotations on the way back up. Leaves are named by the caller's object id.
+//
+// Every leaf also carries the layer bit and mask of its object, and inner
+// nodes the union of those below them, so searches skip whole subtrees that
+// hold nothing on the layers being looked for.
+class AabbTree
+{
+public:
+	enum { NULL_NODE = -1 };
+
+	// A balanced tree this deep would hold far more leaves than memory
+	enum { MAX_QUERY_DEPTH = 128 };
+
+	AabbTree();
+
+	// box is the object's tight bounds; the leaf is that plus margin
+	void Insert(unsigned int objectId, const Aabb &box, float margin,
+		CollisionMask layerBit, CollisionMask mask);
+	void Remove(unsigned int objectId);
+	// Returns true if the leaf had to be reinserted
+	bool Move(unsigned int objectId, const Aabb &box, float margin,
+		CollisionMask layerBit, CollisionMask mask);
+	bool Contains(unsigned int objectId) const;
+	void Clear();
+
+	typedef std::pair<unsigned int, unsigned int> IdPair;
+
+	// Ids of every leaf on one of the layers in mask whose box overlaps box,
+	// added to objectIds. Safe to call from several threads at once while the
+	// tree is not changing.
+	void Query(const Aabb &box, CollisionMask mask, std::vector<unsigned int> *objectIds) const;
+	// Every pair of leaves whose boxes overlap and whose masks accept each
+	// other's layers, found by descending the tree against itself; each pair
+	// once, lower id first, added to pairs
+	void QueryPairs(std::vector<IdPair> *pairs);
+
+	// Walks the leaves on one of the layers in mask depth first. Nodes are
+	// only entered where visitor.Enter(box) is true, and visitor.Visit(id)
+	// is called for every leaf reached. Allocates nothing; like Query it may
+	// run on several threads at once while the tree is not changing.
+	template <typename Visitor>
+	void Traverse(CollisionMask mask, Visitor &visitor) const
+	{
+		if (root_ == NULL_NODE)
+			return;
+
+		int stack[MAX_QUERY_DEPTH];
+		int stackSize = 0;
+		stack[stackSize++] = root_;
+
+		while (stackSize > 0)
+		{
+			const Node &node = nodes_[stack[--stackSize]];
+			if ((node.layerBits & mask) == 0 || !visitor.Enter(node.box))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				visitor.Visit(node.objectId);
+			}
+			else
+			{
+				assert(stackSize + 2 <= MAX_QUERY_DEPTH);
+				stack[stackSize++] = node.child1;
+				stack[stackSize++] = node.child2;
+			}
+		}
+	}
+
+	int GetHeight() const;
+	unsigned int GetNumLeaves() const;
+
+private:
+	struct Node
+	{
+		Aabb box;
+		int parent;
+		int child1;
+		int child2;
+		int height;
+		unsigned int objectId;
+		CollisionMask layerBits;
+		CollisionMask masks;
+
+		bool IsLeaf() const { return child1 == NULL_NODE; }
+	};
+
+	int AllocateNode();
+	void FreeNode(int node);
+	void InsertLeaf(int leaf);
+	void RemoveLeaf(int leaf);
+	int Balance(int node);
+	void Refit(int node);
+	void CombineChildren(int node);
+
+	std::vector<Node> nodes_;
+	std::vector<int> freeNodes_;
+	std::vector<int> leafOf_;
+	int root_;
+	unsigned int numLeaves_;
+
+	// Node pairs still to visit in QueryPairs, kept between calls
+	std::vector<IdPair> pairStack_;
+};
+
+#endif // AABBTREE_H_INCLUDED
@@ -0,0 +1,175 @@
+#include "AabbTreeBroadphase.h"
+#include <algorithm>
+
+namespace
+{
+	const unsigned int NOT_PRESENT = 0xffffffff;
+	const unsigned int COLLIDERS_PER_CHUNK = 256;
+
+	// How far a collider can drift before its leaf is reinserted
+	const float FAT_MARGIN = 4.0f;
+
+	Aabb CircleBox(float x, float y, float radius)
+	{
+		Aabb box;
+		box.minX = x - radius;
+		box.minY = y - radius;
+		box.maxX = x + radius;
+		box.maxY = y + radius;
+		return box;
+	}
+}
+
+AabbTreeBroadphase::AabbTreeBroadphase()
+{
+}
+
+void AabbTreeBroadphase::FindPairs(const BroadphaseInput &input,
+	JobSystem *jobs,
+	std::vector<ColliderPair> *pairs)
+{
+	pairs->clear();
+	UpdateTree(input);
+
+	treePairs_.clear();
+	tree_.QueryPairs(&treePairs_);
+	for (std::vector<AabbTree::IdPair>::const_iterator pairIt = treePairs_.begin(), end = treePairs_.end();
+		pairIt != end;
+		++pairIt)
+	{
+		AddPair(input, pairIt->first, pairIt->second, pairs);
+	}
+
+	// The world wraps but the tree does not, so anything near enough an edge
+	// to touch something across it is looked for again on the far side. A
+	// pair can wrap in x because of one collider and in y because of the
+	// other, so nearness allows for the largest radius about. These lookups
+	// only read the tree, so they are split across jobs.
+	float maxRadius = 0.0f;
+	for (unsigned int index = 0; index < input.count; ++index)
+	{
+		maxRadius = std::max(maxRadius, input.radius[index]);
+	}
+
+	FindPairsInChunks(jobs, input.count, COLLIDERS_PER_CHUNK,
+		[this, &input, maxRadius](unsigned int begin, unsigned int end, std::vector<ColliderPair> *chunkPairs)
+		{
+			FindWrappedPairs(input, maxRadius, begin, end, chunkPairs);
+		},
+		&wrappedPairs_);
+	pairs->insert(pairs->end(), wrappedPairs_.begin(), wrappedPairs_.end());
+
+	std::sort(pairs->begin(), pairs->end(), ColliderPairLess);
+	pairs->erase(std::unique(pairs->begin(), pairs->end(), ColliderPairEqual), pairs->end());
+}
+
+// Looks up the colliders in [begin, end) again across any edge they are near
+void AabbTreeBroadphase::FindWrappedPairs(const BroadphaseInput &input, float maxRadius,
+	unsigned int begin, unsigned int end,
+	std::vector<ColliderPair> *pairs) const
+{
+	const WorldBounds &bounds = input.bounds;
+	float width = bounds.GetWidth();
+	float height = bounds.GetHeight();
+
+	for (unsigned int index = begin; index < end; ++index)
+	{
+		Aabb box = CircleBox(input.positionX[index], input.positionY[index], input.radius[index]);
+		Aabb reach = CircleBox(input.positionX[index], input.positionY[index], input.radius[index] + maxRadius);
+
+		float shiftsX[3] = { 0.0f, 0.0f, 0.0f };
+		float shiftsY[3] = { 0.0f, 0.0f, 0.0f };
+		int numShiftsX = 1;
+		int numShiftsY = 1;
+		if (reach.minX < bounds.minX) shiftsX[numShiftsX++] = width;
+		if (reach.maxX > bounds.maxX) shiftsX[numShiftsX++] = -width;
+		if (reach.minY < bounds.minY) shiftsY[numShiftsY++] = height;
+		if (reach.maxY > bounds.maxY) shiftsY[numShiftsY++] = -height;
+
+		for (int shiftX = 0; shiftX < numShiftsX; ++shiftX)
+		{
+			for (int shiftY = 0; shiftY < numShiftsY; ++shiftY)
+			{
+				if (shiftX == 0 && shiftY == 0)
+					continue;
+
+				WrappedQuery query;
+				query.owner = this;
+				query.input = &input;
+				query.proxyId = input.proxyId[index];
+				query.pairs = pairs;
+				query.box = box;
+				query.box.minX += shiftsX[shiftX];
+				query.box.maxX += shiftsX[shiftX];
+				query.box.minY += shiftsY[shiftY];
+				query.box.maxY += shiftsY[shiftY];
+				tree_.Traverse(input.mask[index], query);
+			}
+		}
+	}
+}
+
+const AabbTree &AabbTreeBroadphase::GetTree() const
+{
+	return tree_;
+}
+
+void AabbTreeBroadphase::UpdateTree(const BroadphaseInput &input)
+{
+	unsigned int maxProxyId = 0;
+	for (unsigned int index = 0; index < input.count; ++index)
+	{
+		maxProxyId = std::max(maxProxyId, input.proxyId[index] + 1);
+	}
+	if (packedIndex_.size() < maxProxyId)
+	{
+		packedIndex_.resize(maxProxyId, NOT_PRESENT);
+	}
+
+	for (std::vector<unsigned int>::const_iterator proxyIt = proxies_.begin(), end = proxies_.end();
+		proxyIt != end;
+		++proxyIt)
+	{
+		packedIndex_[*proxyIt] = NOT_PRESENT;
+	}
+
+	for (unsigned int index = 0; index < input.count; ++index)
+	{
+		packedIndex_[input.proxyId[index]] = index;
+	}
+
+	// Take out proxies that have gone
+	for (std::vector<unsigned int>::const_iterator proxyIt = proxies_.begin(), end = proxies_.end();
+		proxyIt != end;
+		++proxyIt)
+	{
+		if (packedIndex_[*proxyIt] == NOT_PRESENT)
+		{
+			tree_.Remove(*proxyIt);
+		}
+	}
+
+	// Move or add the rest; most stay inside their fattened boxes
+	proxies_.resize(input.count);
+	for (unsigned int index = 0; index < input.count; ++index)
+	{
+		unsigned int proxyId = input.proxyId[index];
+		proxies_[index] = proxyId;
+		tree_.Move(proxyId, CircleBox(input.positionX[index], input.positionY[index], input.radius[index]), FAT_MARGIN,
+			input.layerBit[index], input.mask[index]);
+	}
+}
+
+void AabbTreeBroadphase::AddPair(const BroadphaseInput &input, unsigned int proxyA, unsigned int proxyB,
+	std::vector<ColliderPair> *pairs) const
+{
+	unsigned int a = packedIndex_[proxyA];
+	unsigned int b = packedIndex_[proxyB];
+	if (a == b || !LayersCollide(input, a, b))
+		return;
+
+	ColliderPair pair;
+	pair.a = std::min(a, b);
+	pair.b = std::max(a, b);
+	pairs->push_back(pair);
+}
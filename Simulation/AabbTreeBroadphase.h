@@ -0,0 +1,59 @@
+#ifndef AABBTREEBROADPHASE_H_INCLUDED
+#define AABBTREEBROADPHASE_H_INCLUDED
+
+#include <vector>
+#include "Broadphase.h"
+#include "AabbTree.h"
+
+// Broadphase over a dynamic AABB tree that lives from one pass to the next,
+// with a leaf per proxy id. Each pass only reinserts the colliders that have
+// left their fattened boxes, so it copes with any spread of radii. Pairs come
+// from the tree against itself; colliders close to the world edge are also
+// looked up again shifted to the far side. The tree is updated and walked
+// against itself on the calling thread; the lookups across edges are split
+// across jobs.
+class AabbTreeBroadphase : public Broadphase
+{
+public:
+	AabbTreeBroadphase();
+
+	void FindPairs(const BroadphaseInput &input,
+		JobSystem *jobs,
+		std::vector<ColliderPair> *pairs);
+
+	// Brings the tree up to date with input without looking for pairs, for
+	// when it is wanted for queries while another broadphase finds pairs
+	void UpdateTree(const BroadphaseInput &input);
+	const AabbTree &GetTree() const;
+
+private:
+	// Tree walk for one collider's box shifted across an edge
+	struct WrappedQuery
+	{
+		const AabbTreeBroadphase *owner;
+		const BroadphaseInput *input;
+		unsigned int proxyId;
+		Aabb box;
+		std::vector<ColliderPair> *pairs;
+
+		bool Enter(const Aabb &nodeBox) const { return box.Overlaps(nodeBox); }
+		void Visit(unsigned int objectId) { owner->AddPair(*input, proxyId, objectId, pairs); }
+	};
+
+	void FindWrappedPairs(const BroadphaseInput &input, float maxRadius,
+		unsigned int begin, unsigned int end,
+		std::vector<ColliderPair> *pairs) const;
+	void AddPair(const BroadphaseInput &input, unsigned int proxyA, unsigned int proxyB,
+		std::vector<ColliderPair> *pairs) const;
+
+	AabbTree tree_;
+
+	// Proxy ids in the tree, and each one's packed index this pass
+	std::vector<unsigned int> proxies_;
+	std::vector<unsigned int> packedIndex_;
+
+	std::vector<AabbTree::IdPair> treePairs_;
+	std::vector<ColliderPair> wrappedPairs_;
+};
+
+#endif // AABBTREEBROADPHASE_H_INCLUDED
@@ -0,0 +1,36 @@
+#include "Broadphase.h"
+#include "JobSystem.h"
+
+void Broadphase::FindPairsInChunks(JobSystem *jobs,
+	unsigned int count,
+	unsigned int grainSize,
+	const PairRangeFunction &function,
+	std::vector<ColliderPair> *pairs)
+{
+	pairs->clear();
+
+	unsigned int numChunks = (count + grainSize - 1) / grainSize;
+	if (jobs == nullptr || numChunks <= 1)
+	{
+		function(0, count, pairs);
+		return;
+	}
+
+	// Chunks are fixed by count and grainSize, so the merged order is too
+	if (chunkPairs_.size() < numChunks)
+	{
+		chunkPairs_.resize(numChunks);
+	}
+
+	jobs->ParallelFor(count, grainSize, [this, grainSize, &function](unsigned int begin, unsigned int end)
+	{
+		std::vector<ColliderPair> &chunk = chunkPairs_[begin / grainSize];
+		chunk.clear();
+		function(begin, end, &chunk);
+	});
+
+	for (unsigned int chunk = 0; chunk < numChunks; ++chunk)
+	{
+		pairs->insert(pairs->end(), chunkPairs_[chunk].begin(), chunkPairs_[chunk].end());
+	}
+}
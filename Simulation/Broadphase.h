@@ -0,0 +1,90 @@
+#ifndef BROADPHASE_H_INCLUDED
+#define BROADPHASE_H_INCLUDED
+
+#include <functional>
+#include <vector>
+#include "CollisionLayer.h"
+#include "WorldBounds.h"
+
+class JobSystem;
+
+enum BroadphaseType
+{
+	BROADPHASE_GRID,
+	BROADPHASE_SWEEP_AND_PRUNE,
+	BROADPHASE_AABB_TREE
+};
+
+// Two entries of the packed collider arrays that might be touching; a < b.
+struct ColliderPair
+{
+	unsigned int a;
+	unsigned int b;
+};
+
+inline bool ColliderPairLess(const ColliderPair &lhs, const ColliderPair &rhs)
+{
+	if (lhs.a != rhs.a)
+		return lhs.a < rhs.a;
+	return lhs.b < rhs.b;
+}
+
+inline bool ColliderPairEqual(const ColliderPair &lhs, const ColliderPair &rhs)
+{
+	return lhs.a == rhs.a && lhs.b == rhs.b;
+}
+
+// The enabled colliders for one pass, packed. proxyId identifies a collider
+// across passes even though its packed index changes. layerBit is the bit of
+// each collider's layer and mask the layers it accepts, already combined with
+// the layer matrix.
+struct BroadphaseInput
+{
+	const float *positionX;
+	const float *positionY;
+	const float *radius;
+	const unsigned int *proxyId;
+	const CollisionMask *layerBit;
+	const CollisionMask *mask;
+	unsigned int count;
+	WorldBounds bounds;
+};
+
+// Both colliders have to accept the other's layer
+inline bool LayersCollide(const BroadphaseInput &input, unsigned int a, unsigned int b)
+{
+	return (input.mask[a] & input.layerBit[b]) != 0 && (input.mask[b] & input.layerBit[a]) != 0;
+}
+
+// Finds candidate pairs for the narrowphase. Every implementation must
+// report at least every pair whose circles overlap on the wrapped world and
+// whose layers collide, and no pair whose layers do not, with pairs sorted
+// and unique, so the choice of broadphase never changes results. Given a
+// JobSystem the search may be spread across its threads; the pairs found must
+// not depend on how many there are.
+class Broadphase
+{
+public:
+	virtual ~Broadphase() {}
+
+	virtual void FindPairs(const BroadphaseInput &input,
+		JobSystem *jobs,
+		std::vector<ColliderPair> *pairs) = 0;
+
+protected:
+	typedef std::function<void(unsigned int begin, unsigned int end, std::vector<ColliderPair> *pairs)> PairRangeFunction;
+
+	// Runs function over [0, count) in chunks of grainSize, each chunk adding
+	// to a buffer of its own, then appends the buffers to pairs in chunk
+	// order. Without jobs the whole range goes straight into pairs.
+	void FindPairsInChunks(JobSystem *jobs,
+		unsigned int count,
+		unsigned int grainSize,
+		const PairRangeFunction &function,
+		std::vector<ColliderPair> *pairs);
+
+private:
+	std::vector<std::vector<ColliderPair> > chunkPairs_;
+};
+
+#endif // BROADPHASE_H_INCLUDED
@@ -0,0 +1,20 @@
+#ifndef COLLIDER_H_INCLUDED
+#define COLLIDER_H_INCLUDED
+
+#include "EntityHandle.h"
+
+// The entity a collider belongs to. This is the cold half of a collider;
+// the fields the collision pass reads every tick are kept apart in Collision.
+class Collider
+{
+	friend class Collision;
+public:
+	EntityType GetEntityType() const { return type; }
+	EntityHandle GetEntityHandle() const { return handle; }
+
+private:
+	EntityType type;
+	EntityHandle handle;
+};
+
+#endif // COLLIDER_H_INCLUDED
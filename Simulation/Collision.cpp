@@ -0,0 +1,798 @@
+#include "Collision.h"
+#include "MotionKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Below this a parallel broadphase costs more than it saves
+	const unsigned int MIN_PARALLEL_COLLIDERS = 1024;
+
+	bool IsShip(EntityType type)
+	{
+		return type == ENTITY_TYPE_PLAYER || type == ENTITY_TYPE_ENEMY;
+	}
+
+	// Which kind of contact two colliders make, and whether they need
+	// swapping to put them in the order the kind names them
+	bool ClassifyContact(EntityType a, EntityType b, ContactType *type, bool *swap)
+	{
+		*swap = false;
+		if (IsShip(a) && IsShip(b))
+		{
+			*type = CONTACT_SHIP_SHIP;
+			*swap = a > b;
+			return true;
+		}
+
+		for (int attempt = 0; attempt < 2; ++attempt)
+		{
+			if (IsShip(a) && b == ENTITY_TYPE_ASTEROID)
+			{
+				*type = CONTACT_SHIP_ASTEROID;
+				return true;
+			}
+			if (a == ENTITY_TYPE_BULLET && b == ENTITY_TYPE_ASTEROID)
+			{
+				*type = CONTACT_BULLET_ASTEROID;
+				return true;
+			}
+			if (a == ENTITY_TYPE_BULLET && IsShip(b))
+			{
+				*type = CONTACT_BULLET_SHIP;
+				return true;
+			}
+
+			std::swap(a, b);
+			*swap = !*swap;
+		}
+		return false;
+	}
+
+	// Distance along a wrapping axis from p to the nearest point of [min, max]
+	float GetIntervalDistance(float p, float min, float max, float size)
+	{
+		float length = max - min;
+		if (length >= size)
+			return 0.0f;
+
+		float offset = p - min;
+		offset -= size * std::floor(offset / size);
+		if (offset <= length)
+			return 0.0f;
+
+		return std::min(offset - length, size - offset);
+	}
+
+	// Narrows [*tMin, *tMax] to where o + t * d lies in [min, max]
+	bool ClipToSlab(float o, float d, float min, float max, float *tMin, float *tMax)
+	{
+		if (d == 0.0f)
+			return o >= min && o <= max;
+
+		float t0 = (min - o) / d;
+		float t1 = (max - o) / d;
+		if (t0 > t1)
+			std::swap(t0, t1);
+
+		*tMin = std::max(*tMin, t0);
+		*tMax = std::min(*tMax, t1);
+		return *tMin <= *tMax;
+	}
+
+	// Which copies of the span [min, max], repeated every size, the span
+	// [from, to] reaches
+	void GetCopyRange(float from, float to, float min, float max, float size, int *first, int *last)
+	{
+		*first = static_cast<int>(std::ceil((from - max) / size));
+		*last = static_cast<int>(std::floor((to - min) / size));
+	}
+
+	int CompareColliders(const Collider &lhs, const Collider &rhs)
+	{
+		if (lhs.GetEntityType() != rhs.GetEntityType())
+			return lhs.GetEntityType() < rhs.GetEntityType() ? -1 : 1;
+
+		EntityHandle lhsHandle = lhs.GetEntityHandle();
+		EntityHandle rhsHandle = rhs.GetEntityHandle();
+		if (lhsHandle.index != rhsHandle.index)
+			return lhsHandle.index < rhsHandle.index ? -1 : 1;
+		if (lhsHandle.generation != rhsHandle.generation)
+			return lhsHandle.generation < rhsHandle.generation ? -1 : 1;
+		return 0;
+	}
+
+	bool ContactLess(const Contact &lhs, const Contact &rhs)
+	{
+		if (lhs.type != rhs.type)
+			return lhs.type < rhs.type;
+
+		int first = CompareColliders(lhs.first, rhs.first);
+		if (first != 0)
+			return first < 0;
+		return CompareColliders(lhs.second, rhs.second) < 0;
+	}
+
+	bool ContactEqual(const Contact &lhs, const Contact &rhs)
+	{
+		return lhs.type == rhs.type &&
+			CompareColliders(lhs.first, rhs.first) == 0 &&
+			CompareColliders(lhs.second, rhs.second) == 0;
+	}
+}
+
+Collision::Collision(unsigned int capacity, PoolOverflowPolicy overflowPolicy,
+	const WorldBounds &bounds, JobSystem *jobs) :
+	policy_(overflowPolicy),
+	bounds_(bounds),
+	jobs_(jobs),
+	broadphaseType_(BROADPHASE_GRID),
+	broadphase_(&gridBroadphase_),
+	treeDirty_(false)
+{
+	states_.reserve(capacity);
+	owners_.reserve(capacity);
+	handles_.reserve(capacity);
+	registry_.Reserve(capacity);
+	pendingDestroys_.reserve(capacity);
+	stats_.capacity = capacity;
+	packedBoundsX_.reserve(capacity);
+	packedBoundsY_.reserve(capacity);
+	packedBoundsRadius_.reserve(capacity);
+	packedStartX_.reserve(capacity);
+	packedStartY_.reserve(capacity);
+	packedMoveX_.reserve(capacity);
+	packedMoveY_.reserve(capacity);
+	packedRadius_.reserve(capacity);
+	packedIndices_.reserve(capacity);
+	packedProxyIds_.reserve(capacity);
+	packedLayerBits_.reserve(capacity);
+	packedMasks_.reserve(capacity);
+	contacts_.reserve(capacity);
+
+	for (unsigned int type = 0; type <= CONTACT_TYPE_COUNT; ++type)
+	{
+		contactStart_[type] = 0;
+	}
+
+	for (unsigned int layer = 0; layer < COLLISION_LAYER_COUNT; ++layer)
+	{
+		layerMatrix_[layer] = COLLISION_MASK_ALL;
+	}
+}
+
+Collision::~Collision()
+{
+}
+
+bool Collision::CanCreateCollider() const
+{
+	return policy_ == POOL_OVERFLOW_GROW || states_.size() < stats_.capacity;
+}
+
+ColliderHandle Collision::CreateCollider(EntityType type, EntityHandle owner, CollisionLayer layer)
+{
+	if (states_.size() >= stats_.capacity)
+	{
+		++stats_.overflows;
+		if (policy_ != POOL_OVERFLOW_GROW)
+			return ColliderHandle();
+	}
+
+	ColliderState state;
+	state.position = XMFLOAT2(0.0f, 0.0f);
+	state.sweepStart = state.position;
+	state.radius = 0.0f;
+	state.mask = COLLISION_MASK_ALL;
+	state.layer = layer;
+	state.enabled = true;
+	state.swept = false;
+
+	Collider collider;
+	collider.type = type;
+	collider.handle = owner;
+
+	unsigned int index = static_cast<unsigned int>(states_.size());
+	ColliderHandle handle = registry_.Create(index);
+	states_.push_back(state);
+	owners_.push_back(collider);
+	handles_.push_back(handle);
+	stats_.OnAdd();
+
+	return handle;
+}
+
+void Collision::DestroyCollider(ColliderHandle collider)
+{
+	ColliderState *state = FindState(collider);
+	if (state == nullptr)
+		return;
+
+	state->enabled = false;
+	pendingDestroys_.push_back(collider);
+}
+
+void Collision::ApplyPendingChanges()
+{
+	for (std::vector<ColliderHandle>::const_iterator handleIt = pendingDestroys_.begin(), end = pendingDestroys_.end();
+		handleIt != end;
+		++handleIt)
+	{
+		// Destroying twice in one tick queues the handle twice
+		unsigned int index;
+		if (registry_.Resolve(*handleIt, &index))
+		{
+			RemoveCollider(index);
+		}
+	}
+	pendingDestroys_.clear();
+}
+
+void Collision::UpdateColliderPosition(ColliderHandle collider, const XMFLOAT3 &position)
+{
+	ColliderState *state = FindState(collider);
+	if (state)
+	{
+		state->position = XMFLOAT2(position.x, position.y);
+	}
+}
+
+void Collision::UpdateColliderRadius(ColliderHandle collider, float radius)
+{
+	ColliderState *state = FindState(collider);
+	if (state)
+	{
+		state->radius = radius;
+	}
+}
+
+void Collision::EnableCollider(ColliderHandle collider)
+{
+	ColliderState *state = FindState(collider);
+	if (state)
+	{
+		state->enabled = true;
+	}
+}
+
+void Collision::DisableCollider(ColliderHandle collider)
+{
+	ColliderState *state = FindState(collider);
+	if (state)
+	{
+		state->enabled = false;
+	}
+}
+
+void Collision::SetColliderMask(ColliderHandle collider, CollisionMask mask)
+{
+	ColliderState *state = FindState(collider);
+	if (state)
+	{
+		state->mask = mask;
+	}
+}
+
+void Collision::SetColliderSwept(ColliderHandle collider, bool swept)
+{
+	ColliderState *state = FindState(collider);
+	if (state)
+	{
+		state->swept = swept;
+		state->sweepStart = state->position;
+	}
+}
+
+void Collision::SetLayersCollide(CollisionLayer a, CollisionLayer b, bool collide)
+{
+	if (collide)
+	{
+		layerMatrix_[a] |= CollisionLayerBit(b);
+		layerMatrix_[b] |= CollisionLayerBit(a);
+	}
+	else
+	{
+		layerMatrix_[a] &= ~CollisionLayerBit(b);
+		layerMatrix_[b] &= ~CollisionLayerBit(a);
+	}
+}
+
+bool Collision::GetLayersCollide(CollisionLayer a, CollisionLayer b) const
+{
+	return (layerMatrix_[a] & CollisionLayerBit(b)) != 0;
+}
+
+void Collision::FindContacts()
+{
+	packedBoundsX_.clear();
+	packedBoundsY_.clear();
+	packedBoundsRadius_.clear();
+	packedStartX_.clear();
+	packedStartY_.clear();
+	packedMoveX_.clear();
+	packedMoveY_.clear();
+	packedRadius_.clear();
+	packedIndices_.clear();
+	packedProxyIds_.clear();
+	packedLayerBits_.clear();
+	packedMasks_.clear();
+
+	unsigned int numColliders = static_cast<unsigned int>(states_.size());
+	for (unsigned int index = 0; index < numColliders; ++index)
+	{
+		const ColliderState &state = states_[index];
+		if (state.enabled)
+		{
+			// A sweep goes to the broadphase as a circle around its whole path
+			XMFLOAT2 start;
+			XMFLOAT2 displacement;
+			GetSweep(state, &start, &displacement);
+			float halfLength = 0.5f * std::sqrt(displacement.x * displacement.x + displacement.y * displacement.y);
+
+			packedBoundsX_.push_back(MotionKernels::WrapValue(start.x + 0.5f * displacement.x, bounds_.minX, bounds_.maxX));
+			packedBoundsY_.push_back(MotionKernels::WrapValue(start.y + 0.5f * displacement.y, bounds_.minY, bounds_.maxY));
+			packedBoundsRadius_.push_back(state.radius + halfLength);
+			packedStartX_.push_back(start.x);
+			packedStartY_.push_back(start.y);
+			packedMoveX_.push_back(displacement.x);
+			packedMoveY_.push_back(displacement.y);
+			packedRadius_.push_back(state.radius);
+			packedIndices_.push_back(index);
+			packedProxyIds_.push_back(handles_[index].index);
+			if (handles_[index].index >= proxyHandles_.size())
+			{
+				proxyHandles_.resize(handles_[index].index + 1);
+			}
+			proxyHandles_[handles_[index].index] = handles_[index];
+			packedLayerBits_.push_back(CollisionLayerBit(state.layer));
+			packedMasks_.push_back(state.mask & layerMatrix_[state.layer]);
+		}
+	}
+
+	BroadphaseInput input;
+	input.positionX = packedBoundsX_.data();
+	input.positionY = packedBoundsY_.data();
+	input.radius = packedBoundsRadius_.data();
+	input.proxyId = packedProxyIds_.data();
+	input.layerBit = packedLayerBits_.data();
+	input.mask = packedMasks_.data();
+	input.count = static_cast<unsigned int>(packedIndices_.size());
+	input.bounds = bounds_;
+	JobSystem *broadphaseJobs = input.count >= MIN_PARALLEL_COLLIDERS ? jobs_ : nullptr;
+	broadphase_->FindPairs(input, broadphaseJobs, &pairs_);
+
+	// Queries always search the tree, whichever broadphase found the pairs;
+	// if that was not the tree it is left for the first query to refit
+	treeInput_ = input;
+	treeDirty_.store(broadphase_ != &aabbTreeBroadphase_, std::memory_order_release);
+
+	NarrowphaseInput narrowphase;
+	narrowphase.startX = packedStartX_.data();
+	narrowphase.startY = packedStartY_.data();
+	narrowphase.moveX = packedMoveX_.data();
+	narrowphase.moveY = packedMoveY_.data();
+	narrowphase.radius = packedRadius_.data();
+	narrowphase.bounds = bounds_;
+
+	touching_.resize(pairs_.size());
+	unsigned int numTouching = NarrowphaseKernels::TestPairs(narrowphase,
+		pairs_.data(),
+		static_cast<unsigned int>(pairs_.size()),
+		touching_.data());
+	touching_.resize(numTouching);
+
+	contacts_.clear();
+	for (std::vector<ColliderPair>::const_iterator pairIt = touching_.begin(), end = touching_.end();
+		pairIt != end;
+		++pairIt)
+	{
+		const Collider &colliderA = owners_[packedIndices_[pairIt->a]];
+		const Collider &colliderB = owners_[packedIndices_[pairIt->b]];
+
+		Contact contact;
+		bool swap;
+		if (!ClassifyContact(colliderA.GetEntityType(), colliderB.GetEntityType(), &contact.type, &swap))
+			continue;
+
+		contact.first = swap ? colliderB : colliderA;
+		contact.second = swap ? colliderA : colliderB;
+		contacts_.push_back(contact);
+	}
+
+	std::sort(contacts_.begin(), contacts_.end(), ContactLess);
+	contacts_.erase(std::unique(contacts_.begin(), contacts_.end(), ContactEqual), contacts_.end());
+
+	// Where each type's run begins
+	unsigned int numContacts = static_cast<unsigned int>(contacts_.size());
+	unsigned int contact = 0;
+	for (unsigned int type = 0; type < CONTACT_TYPE_COUNT; ++type)
+	{
+		contactStart_[type] = contact;
+		while (contact < numContacts && contacts_[contact].type == static_cast<ContactType>(type))
+		{
+			++contact;
+		}
+	}
+	contactStart_[CONTACT_TYPE_COUNT] = numContacts;
+
+	// The next sweep starts where this pass left off
+	for (std::vector<ColliderState>::iterator stateIt = states_.begin(), end = states_.end();
+		stateIt != end;
+		++stateIt)
+	{
+		if (stateIt->swept)
+		{
+			stateIt->sweepStart = stateIt->position;
+		}
+	}
+}
+
+const Contact *Collision::GetContacts(ContactType type, unsigned int *count) const
+{
+	*count = contactStart_[type + 1] - contactStart_[type];
+	return contacts_.data() + contactStart_[type];
+}
+
+struct Collision::CircleQuery
+{
+	const Collision *collision;
+	XMFLOAT2 centre;
+	float radius;
+	ColliderHandle *colliders;
+	unsigned int maxResults;
+	unsigned int count;
+
+	bool Enter(const Aabb &box) const
+	{
+		return count < maxResults && collision->GetBoxDistanceSq(centre, box) <= radius * radius;
+	}
+
+	void Visit(unsigned int proxyId)
+	{
+		ColliderHandle collider;
+		const ColliderState *state = collision->FindQueryCandidate(proxyId, &collider);
+		if (state == nullptr)
+			return;
+
+		XMFLOAT2 offset = collision->GetWrappedOffset(centre, state->position);
+		float reach = radius + state->radius;
+		if (offset.x * offset.x + offset.y * offset.y < reach * reach)
+		{
+			colliders[count++] = collider;
+		}
+	}
+};
+
+struct Collision::NearestQuery
+{
+	const Collision *collision;
+	XMFLOAT2 point;
+	ColliderHandle *colliders;
+	float *distances;
+	unsigned int maxResults;
+	unsigned int count;
+
+	bool Enter(const Aabb &box) const
+	{
+		if (count < maxResults)
+			return true;
+
+		float furthest = distances[count - 1];
+		return collision->GetBoxDistanceSq(point, box) <= furthest * furthest;
+	}
+
+	void Visit(unsigned int proxyId)
+	{
+		ColliderHandle collider;
+		const ColliderState *state = collision->FindQueryCandidate(proxyId, &collider);
+		if (state == nullptr)
+			return;
+
+		XMFLOAT2 offset = collision->GetWrappedOffset(point, state->position);
+		float distance = std::max(std::sqrt(offset.x * offset.x + offset.y * offset.y) - state->radius, 0.0f);
+
+		unsigned int slot;
+		if (count < maxResults)
+		{
+			slot = count++;
+		}
+		else if (IsCloser(distance, collider, count - 1))
+		{
+			slot = count - 1;
+		}
+		else
+		{
+			return;
+		}
+
+		// Insertion sort; equal distances go by slot index so the order
+		// does not depend on the shape of the tree
+		while (slot > 0 && IsCloser(distance, collider, slot - 1))
+		{
+			colliders[slot] = colliders[slot - 1];
+			distances[slot] = distances[slot - 1];
+			--slot;
+		}
+		colliders[slot] = collider;
+		distances[slot] = distance;
+	}
+
+	bool IsCloser(float distance, ColliderHandle collider, unsigned int slot) const
+	{
+		if (distance != distances[slot])
+			return distance < distances[slot];
+
+		return collider.index < colliders[slot].index;
+	}
+};
+
+// The segment is followed unwrapped, and meets every copy of a box or circle
+// repeated across the plane at the world's width and height
+struct Collision::RayQuery
+{
+	const Collision *collision;
+	XMFLOAT2 origin;
+	XMFLOAT2 direction;
+	RaycastHit *hit;
+	bool found;
+
+	bool Enter(const Aabb &box) const
+	{
+		float width = collision->bounds_.GetWidth();
+		float height = collision->bounds_.GetHeight();
+		float endX = origin.x + direction.x * hit->distance;
+		float endY = origin.y + direction.y * hit->distance;
+
+		int firstX, lastX, firstY, lastY;
+		GetCopyRange(std::min(origin.x, endX), std::max(origin.x, endX), box.minX, box.maxX, width, &firstX, &lastX);
+		GetCopyRange(std::min(origin.y, endY), std::max(origin.y, endY), box.minY, box.maxY, height, &firstY, &lastY);
+
+		for (int copyX = firstX; copyX <= lastX; ++copyX)
+		{
+			for (int copyY = firstY; copyY <= lastY; ++copyY)
+			{
+				float shiftX = copyX * width;
+				float shiftY = copyY * height;
+				float tMin = 0.0f;
+				float tMax = hit->distance;
+				if (ClipToSlab(origin.x, direction.x, box.minX + shiftX, box.maxX + shiftX, &tMin, &tMax) &&
+					ClipToSlab(origin.y, direction.y, box.minY + shiftY, box.maxY + shiftY, &tMin, &tMax))
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	void Visit(unsigned int proxyId)
+	{
+		ColliderHandle collider;
+		const ColliderState *state = collision->FindQueryCandidate(proxyId, &collider);
+		if (state == nullptr)
+			return;
+
+		const WorldBounds &bounds = collision->bounds_;
+		float width = bounds.GetWidth();
+		float height = bounds.GetHeight();
+		float radius = state->radius;
+		float endX = origin.x + direction.x * hit->distance;
+		float endY = origin.y + direction.y * hit->distance;
+
+		int firstX, lastX, firstY, lastY;
+		GetCopyRange(std::min(origin.x, endX), std::max(origin.x, endX),
+			state->position.x - radius, state->position.x + radius, width, &firstX, &lastX);
+		GetCopyRange(std::min(origin.y, endY), std::max(origin.y, endY),
+			state->position.y - radius, state->position.y + radius, height, &firstY, &lastY);
+
+		for (int copyX = firstX; copyX <= lastX; ++copyX)
+		{
+			for (int copyY = firstY; copyY <= lastY; ++copyY)
+			{
+				float centreX = state->position.x + copyX * width;
+				float centreY = state->position.y + copyY * height;
+				float offsetX = origin.x - centreX;
+				float offsetY = origin.y - centreY;
+				float along = offsetX * direction.x + offsetY * direction.y;
+				float excess = offsetX * offsetX + offsetY * offsetY - radius * radius;
+
+				// Starting inside counts as a hit straight away
+				float t = 0.0f;
+				if (excess > 0.0f)
+				{
+					float discriminant = along * along - excess;
+					if (along > 0.0f || discriminant < 0.0f)
+						continue;
+
+					t = -along - std::sqrt(discriminant);
+				}
+
+				if (t > hit->distance || (found && t == hit->distance && collider.index >= hit->collider.index))
+					continue;
+
+				float pointX = origin.x + direction.x * t;
+				float pointY = origin.y + direction.y * t;
+				found = true;
+				hit->collider = collider;
+				hit->distance = t;
+				hit->point.x = MotionKernels::WrapValue(pointX, bounds.minX, bounds.maxX);
+				hit->point.y = MotionKernels::WrapValue(pointY, bounds.minY, bounds.maxY);
+				if (excess > 0.0f)
+				{
+					hit->normal.x = (pointX - centreX) / radius;
+					hit->normal.y = (pointY - centreY) / radius;
+				}
+				else
+				{
+					hit->normal.x = -direction.x;
+					hit->normal.y = -direction.y;
+				}
+			}
+		}
+	}
+};
+
+unsigned int Collision::OverlapCircle(const XMFLOAT2 &centre, float radius, CollisionMask layers,
+	ColliderHandle *colliders, unsigned int maxResults) const
+{
+	CircleQuery query;
+	query.collision = this;
+	query.centre = centre;
+	query.radius = radius;
+	query.colliders = colliders;
+	query.maxResults = maxResults;
+	query.count = 0;
+	GetQueryTree().Traverse(layers, query);
+	return query.count;
+}
+
+unsigned int Collision::FindNearest(const XMFLOAT2 &point, CollisionMask layers,
+	ColliderHandle *colliders, float *distances, unsigned int maxResults) const
+{
+	if (maxResults == 0)
+		return 0;
+
+	NearestQuery query;
+	query.collision = this;
+	query.point = point;
+	query.colliders = colliders;
+	query.distances = distances;
+	query.maxResults = maxResults;
+	query.count = 0;
+	GetQueryTree().Traverse(layers, query);
+	return query.count;
+}
+
+bool Collision::Raycast(const XMFLOAT2 &origin, const XMFLOAT2 &direction, float maxDistance,
+	CollisionMask layers, RaycastHit *hit) const
+{
+	float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+	if (length == 0.0f || maxDistance < 0.0f)
+		return false;
+
+	RayQuery query;
+	query.collision = this;
+	query.origin = origin;
+	query.direction = XMFLOAT2(direction.x / length, direction.y / length);
+	query.hit = hit;
+	query.found = false;
+	hit->distance = maxDistance;
+	GetQueryTree().Traverse(layers, query);
+	return query.found;
+}
+
+// Several threads may query at once, so only one of them does the refit
+const AabbTree &Collision::GetQueryTree() const
+{
+	if (treeDirty_.load(std::memory_order_acquire))
+	{
+		std::lock_guard<std::mutex> lock(treeMutex_);
+		if (treeDirty_.load(std::memory_order_relaxed))
+		{
+			aabbTreeBroadphase_.UpdateTree(treeInput_);
+			treeDirty_.store(false, std::memory_order_release);
+		}
+	}
+
+	return aabbTreeBroadphase_.GetTree();
+}
+
+void Collision::SetBroadphase(BroadphaseType type)
+{
+	broadphaseType_ = type;
+	switch (type)
+	{
+	case BROADPHASE_SWEEP_AND_PRUNE:
+		broadphase_ = &sweepAndPruneBroadphase_;
+		break;
+	case BROADPHASE_AABB_TREE:
+		broadphase_ = &aabbTreeBroadphase_;
+		break;
+	default:
+		broadphase_ = &gridBroadphase_;
+		break;
+	}
+}
+
+BroadphaseType Collision::GetBroadphase() const
+{
+	return broadphaseType_;
+}
+
+const PoolStats &Collision::GetColliderPoolStats() const
+{
+	return stats_;
+}
+
+Collision::ColliderState *Collision::FindState(ColliderHandle collider)
+{
+	unsigned int index;
+	if (!registry_.Resolve(collider, &index))
+		return nullptr;
+
+	return &states_[index];
+}
+
+const Collision::ColliderState *Collision::FindQueryCandidate(unsigned int proxyId, ColliderHandle *collider) const
+{
+	*collider = proxyHandles_[proxyId];
+
+	// Gone or switched off since the tree was last brought up to date
+	unsigned int index;
+	if (!registry_.Resolve(*collider, &index) || !states_[index].enabled)
+		return nullptr;
+
+	return &states_[index];
+}
+
+XMFLOAT2 Collision::GetWrappedOffset(const XMFLOAT2 &from, const XMFLOAT2 &to) const
+{
+	float width = bounds_.GetWidth();
+	float height = bounds_.GetHeight();
+	return XMFLOAT2(MotionKernels::WrapDelta(to.x - from.x, width, 1.0f / width),
+		MotionKernels::WrapDelta(to.y - from.y, height, 1.0f / height));
+}
+
+float Collision::GetBoxDistanceSq(const XMFLOAT2 &point, const Aabb &box) const
+{
+	float distanceX = GetIntervalDistance(point.x, box.minX, box.maxX, bounds_.GetWidth());
+	float distanceY = GetIntervalDistance(point.y, box.minY, box.maxY, bounds_.GetHeight());
+	return distanceX * distanceX + distanceY * distanceY;
+}
+
+// Swap the last collider into the hole, as World does for entities
+void Collision::RemoveCollider(unsigned int index)
+{
+	unsigned int last = static_cast<unsigned int>(states_.size()) - 1;
+	registry_.Destroy(handles_[index]);
+	if (index != last)
+	{
+		states_[index] = states_[last];
+		owners_[index] = owners_[last];
+		handles_[index] = handles_[last];
+		registry_.Move(handles_[index], index);
+	}
+
+	states_.pop_back();
+	owners_.pop_back();
+	handles_.pop_back();
+	stats_.OnRemove();
+}
+
+// Where a collider's motion this pass began and how far it went. Colliders
+// that are not swept are treated as standing still where they are now.
+void Collision::GetSweep(const ColliderState &state, XMFLOAT2 *start, XMFLOAT2 *displacement) const
+{
+	if (!state.swept)
+	{
+		*start = state.position;
+		*displacement = XMFLOAT2(0.0f, 0.0f);
+		return;
+	}
+
+	float width = bounds_.GetWidth();
+	float height = bounds_.GetHeight();
+	*start = state.sweepStart;
+	displacement->x = MotionKernels::WrapDelta(state.position.x - state.sweepStart.x, width, 1.0f / width);
+	displacement->y = MotionKernels::WrapDelta(state.position.y - state.sweepStart.y, height, 1.0f / height);
+}
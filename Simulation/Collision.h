@@ -0,0 +1,180 @@
+#ifndef COLLISION_H_INCLUDED
+#define COLLISION_H_INCLUDED
+
+#include <DirectXMath.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "EntityHandle.h"
+#include "CollisionLayer.h"
+#include "HandleRegistry.h"
+#include "PoolStats.h"
+#include "Collider.h"
+#include "Contact.h"
+#include "WorldBounds.h"
+#include "GridBroadphase.h"
+#include "SweepAndPruneBroadphase.h"
+#include "AabbTreeBroadphase.h"
+#include "NarrowphaseKernels.h"
+
+using namespace DirectX;
+
+class JobSystem;
+
+struct RaycastHit
+{
+	ColliderHandle collider;
+	float distance;
+	XMFLOAT2 point;
+	XMFLOAT2 normal;
+};
+
+// Colliders live in a slot map: dense arrays walked front to back every pass,
+// addressed from outside through generational handles. The per-tick fields
+// are kept apart from the owning entity, which is only read for contacts.
+// A destroyed collider stops colliding immediately but keeps its slot until
+// ApplyPendingChanges(), so the arrays never shift while FindContacts is
+// walking them. Storage is reserved up front; callers check
+// CanCreateCollider() to honour the overflow policy.
+// Pairs whose layers are not set to collide in the layer matrix are dropped in
+// the broadphase and never reach the narrowphase.
+//
+// FindContacts() only detects: it leaves a stream of typed contacts, sorted
+// by type and then by the entities involved and free of duplicates, for the
+// game to respond to a type at a time.
+//
+// Swept colliders are tested along the whole path they moved since the last
+// pass rather than only where they ended up, so a fast mover cannot step over
+// a target smaller than its stride. Motion is treated as linear over the tick.
+class Collision
+{
+public:
+	// jobs may be null, in which case everything runs on the calling thread
+	Collision(unsigned int capacity, PoolOverflowPolicy overflowPolicy,
+		const WorldBounds &bounds, JobSystem *jobs);
+	~Collision();
+
+	bool CanCreateCollider() const;
+	// Returns an invalid handle if full under POOL_OVERFLOW_FAIL
+	ColliderHandle CreateCollider(EntityType type, EntityHandle owner, CollisionLayer layer);
+	void DestroyCollider(ColliderHandle collider);
+
+	void UpdateColliderPosition(ColliderHandle collider, const XMFLOAT3 &position);
+	void UpdateColliderRadius(ColliderHandle collider, float radius);
+	void EnableCollider(ColliderHandle collider);
+	void DisableCollider(ColliderHandle collider);
+	void SetColliderMask(ColliderHandle collider, CollisionMask mask);
+	// The first sweep starts from wherever the collider is now
+	void SetColliderSwept(ColliderHandle collider, bool swept);
+
+	// Symmetric; every layer collides with every other until told otherwise
+	void SetLayersCollide(CollisionLayer a, CollisionLayer b, bool collide);
+	bool GetLayersCollide(CollisionLayer a, CollisionLayer b) const;
+
+	void ApplyPendingChanges();
+	void FindContacts();
+	const Contact *GetContacts(ContactType type, unsigned int *count) const;
+
+	// Spatial queries. They search the AABB tree as it stood at the last
+	// FindContacts() and check what they find against where colliders are
+	// now, so colliders created since are not found until the next pass.
+	// layers is a mask of the layers to look on; disabled colliders are
+	// never found and everything wraps around the world edges. Results go
+	// into the caller's arrays and nothing is allocated, so any number of
+	// threads may query at once while the colliders are left alone. When
+	// another broadphase finds the pairs, the tree is only brought up to date
+	// by the first query after FindContacts().
+
+	// Colliders touching the circle, up to maxResults; returns how many
+	unsigned int OverlapCircle(const XMFLOAT2 &centre, float radius, CollisionMask layers,
+		ColliderHandle *colliders, unsigned int maxResults) const;
+	// The maxResults colliders whose edges are nearest point, nearest first,
+	// with the distance to each edge (0 from inside); returns how many
+	unsigned int FindNearest(const XMFLOAT2 &point, CollisionMask layers,
+		ColliderHandle *colliders, float *distances, unsigned int maxResults) const;
+	// The first collider met along the segment from origin covering
+	// maxDistance in direction
+	bool Raycast(const XMFLOAT2 &origin, const XMFLOAT2 &direction, float maxDistance,
+		CollisionMask layers, RaycastHit *hit) const;
+
+	void SetBroadphase(BroadphaseType type);
+	BroadphaseType GetBroadphase() const;
+
+	const PoolStats &GetColliderPoolStats() const;
+
+private:
+
+	// What the collision pass reads and writes every tick
+	struct ColliderState
+	{
+		XMFLOAT2 position;
+		XMFLOAT2 sweepStart;
+		float radius;
+		CollisionMask mask;
+		CollisionLayer layer;
+		bool enabled;
+		bool swept;
+	};
+
+	// Tree visitors for the queries, nested so they can read the states
+	struct CircleQuery;
+	struct NearestQuery;
+	struct RayQuery;
+
+	ColliderState *FindState(ColliderHandle collider);
+	const ColliderState *FindQueryCandidate(unsigned int proxyId, ColliderHandle *collider) const;
+	XMFLOAT2 GetWrappedOffset(const XMFLOAT2 &from, const XMFLOAT2 &to) const;
+	float GetBoxDistanceSq(const XMFLOAT2 &point, const Aabb &box) const;
+	void RemoveCollider(unsigned int index);
+	void GetSweep(const ColliderState &state, XMFLOAT2 *start, XMFLOAT2 *displacement) const;
+	const AabbTree &GetQueryTree() const;
+
+	// Parallel dense arrays, one entry per live collider
+	std::vector<ColliderState> states_;
+	std::vector<Collider> owners_;
+	std::vector<ColliderHandle> handles_;
+	HandleRegistry registry_;
+	std::vector<ColliderHandle> pendingDestroys_;
+	PoolOverflowPolicy policy_;
+	PoolStats stats_;
+
+	WorldBounds bounds_;
+	JobSystem *jobs_;
+	CollisionMask layerMatrix_[COLLISION_LAYER_COUNT];
+
+	// Enabled colliders packed for the broadphase and narrowphase, rebuilt
+	// every pass. The bounds are circles around each collider's whole sweep.
+	std::vector<float> packedBoundsX_;
+	std::vector<float> packedBoundsY_;
+	std::vector<float> packedBoundsRadius_;
+	std::vector<float> packedStartX_;
+	std::vector<float> packedStartY_;
+	std::vector<float> packedMoveX_;
+	std::vector<float> packedMoveY_;
+	std::vector<float> packedRadius_;
+	std::vector<unsigned int> packedIndices_;
+	std::vector<unsigned int> packedProxyIds_;
+	std::vector<CollisionMask> packedLayerBits_;
+	std::vector<CollisionMask> packedMasks_;
+	// Which collider each proxy id belonged to at the last pass, so queries
+	// can be answered from the tree
+	std::vector<ColliderHandle> proxyHandles_;
+	std::vector<ColliderPair> pairs_;
+	std::vector<ColliderPair> touching_;
+	std::vector<Contact> contacts_;
+	unsigned int contactStart_[CONTACT_TYPE_COUNT + 1];
+
+	BroadphaseType broadphaseType_;
+	Broadphase *broadphase_;
+	GridBroadphase gridBroadphase_;
+	SweepAndPruneBroadphase sweepAndPruneBroadphase_;
+	// Refitted from treeInput_ inside the const queries when it is not the
+	// active broadphase
+	mutable AabbTreeBroadphase aabbTreeBroadphase_;
+	BroadphaseInput treeInput_;
+	mutable std::atomic<bool> treeDirty_;
+	mutable std::mutex treeMutex_;
+
+};
+
+#endif // COLLISION_H_INCLUDED
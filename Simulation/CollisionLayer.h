@@ -0,0 +1,32 @@
+#ifndef COLLISIONLAYER_H_INCLUDED
+#define COLLISIONLAYER_H_INCLUDED
+
+#include <stdint.h>
+
+// Every collider sits on one layer. Which layers can touch is decided by the
+// layer matrix in Collision, and a collider can narrow that further with its
+// own mask.
+enum CollisionLayer
+{
+	COLLISION_LAYER_DEFAULT = 0,
+	COLLISION_LAYER_PLAYER,
+	COLLISION_LAYER_ENEMY,
+	COLLISION_LAYER_ASTEROID,
+	COLLISION_LAYER_PLAYER_BULLET,
+	COLLISION_LAYER_ENEMY_BULLET,
+
+	COLLISION_LAYER_COUNT
+};
+
+// One bit per layer
+typedef uint32_t CollisionMask;
+
+const CollisionMask COLLISION_MASK_NONE = 0;
+const CollisionMask COLLISION_MASK_ALL = 0xffffffff;
+
+inline CollisionMask CollisionLayerBit(CollisionLayer layer)
+{
+	return static_cast<CollisionMask>(1) << layer;
+}
+
+#endif // COLLISIONLAYER_H_INCLUDED
@@ -0,0 +1,96 @@
+#include "CommandBuffer.h"
+#include <algorithm>
+
+namespace
+{
+	// Kills are ordered by target so duplicates sit together; everything
+	// else keeps the order it was recorded in.
+	bool CommandLess(const CommandBuffer::Command &a, const CommandBuffer::Command &b)
+	{
+		if (a.type != b.type)
+			return a.type < b.type;
+
+		if (a.type == CommandBuffer::COMMAND_KILL)
+		{
+			if (a.entityType != b.entityType)
+				return a.entityType < b.entityType;
+			if (a.handle.index != b.handle.index)
+				return a.handle.index < b.handle.index;
+		}
+
+		return a.sequence < b.sequence;
+	}
+}
+
+CommandBuffer::CommandBuffer(unsigned int capacity)
+{
+	commands_.reserve(capacity);
+}
+
+void CommandBuffer::Kill(EntityType entityType, EntityHandle handle)
+{
+	Command &command = Append(COMMAND_KILL);
+	command.entityType = entityType;
+	command.handle = handle;
+}
+
+void CommandBuffer::SpawnAsteroid(const XMFLOAT2 &position, int size)
+{
+	Command &command = Append(COMMAND_SPAWN_ASTEROID);
+	command.position = position;
+	command.size = size;
+}
+
+void CommandBuffer::SpawnExplosion(const XMFLOAT2 &position, int size)
+{
+	Command &command = Append(COMMAND_SPAWN_EXPLOSION);
+	command.position = position;
+	command.size = size;
+}
+
+void CommandBuffer::SpawnBullet(Owner owner, const XMFLOAT2 &position,
+	const XMFLOAT2 &velocity, float lifeTime)
+{
+	Command &command = Append(COMMAND_SPAWN_BULLET);
+	command.owner = owner;
+	command.position = position;
+	command.velocity = velocity;
+	command.lifeTime = lifeTime;
+}
+
+void CommandBuffer::Sort()
+{
+	std::sort(commands_.begin(), commands_.end(), CommandLess);
+}
+
+void CommandBuffer::Clear()
+{
+	commands_.clear();
+}
+
+unsigned int CommandBuffer::Size() const
+{
+	return static_cast<unsigned int>(commands_.size());
+}
+
+const CommandBuffer::Command &CommandBuffer::GetCommand(unsigned int index) const
+{
+	return commands_[index];
+}
+
+CommandBuffer::Command &CommandBuffer::Append(CommandType type)
+{
+	Command command;
+	command.type = type;
+	command.sequence = Size();
+	command.entityType = ENTITY_TYPE_NONE;
+	command.handle = EntityHandle();
+	command.position = XMFLOAT2(0.0f, 0.0f);
+	command.velocity = XMFLOAT2(0.0f, 0.0f);
+	command.size = 0;
+	command.owner = Player;
+	command.lifeTime = 0.0f;
+
+	commands_.push_back(command);
+	return commands_.back();
+}
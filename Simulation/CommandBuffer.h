@@ -0,0 +1,64 @@
+#ifndef COMMANDBUFFER_H_INCLUDED
+#define COMMANDBUFFER_H_INCLUDED
+
+#include <DirectXMath.h>
+#include <vector>
+#include "World.h"
+#include "EntityHandle.h"
+
+using namespace DirectX;
+
+// Structural changes requested while the world is being iterated. Nothing
+// here touches the World; Game applies the whole buffer at one sync point per
+// tick, after Sort() has grouped it so kills land first and each kind of
+// spawn is appended to its arrays in one run.
+class CommandBuffer
+{
+public:
+	// Declaration order is application order
+	enum CommandType
+	{
+		COMMAND_KILL,
+		COMMAND_SPAWN_ASTEROID,
+		COMMAND_SPAWN_EXPLOSION,
+		COMMAND_SPAWN_BULLET
+	};
+
+	struct Command
+	{
+		CommandType type;
+		unsigned int sequence;
+
+		// Kill
+		EntityType entityType;
+		EntityHandle handle;
+
+		// Spawns
+		XMFLOAT2 position;
+		XMFLOAT2 velocity;
+		int size;
+		Owner owner;
+		float lifeTime;
+	};
+
+	explicit CommandBuffer(unsigned int capacity);
+
+	void Kill(EntityType entityType, EntityHandle handle);
+	void SpawnAsteroid(const XMFLOAT2 &position, int size);
+	void SpawnExplosion(const XMFLOAT2 &position, int size);
+	void SpawnBullet(Owner owner, const XMFLOAT2 &position,
+		const XMFLOAT2 &velocity, float lifeTime);
+
+	void Sort();
+	void Clear();
+
+	unsigned int Size() const;
+	const Command &GetCommand(unsigned int index) const;
+
+private:
+	Command &Append(CommandType type);
+
+	std::vector<Command> commands_;
+};
+
+#endif // COMMANDBUFFER_H_INCLUDED
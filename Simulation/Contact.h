@@ -0,0 +1,28 @@
+#ifndef CONTACT_H_INCLUDED
+#define CONTACT_H_INCLUDED
+
+#include "Collider.h"
+
+// The kinds of touching pair the collision pass reports, in the order they
+// appear in the contact stream. Ships are the player and the enemy.
+enum ContactType
+{
+	CONTACT_SHIP_ASTEROID,
+	CONTACT_SHIP_SHIP,
+	CONTACT_BULLET_ASTEROID,
+	CONTACT_BULLET_SHIP,
+
+	CONTACT_TYPE_COUNT
+};
+
+// Two colliders found touching. first is whichever is named first in the
+// contact type, so a bullet-asteroid contact always has the bullet in first;
+// in a ship-ship contact first is the player.
+struct Contact
+{
+	ContactType type;
+	Collider first;
+	Collider second;
+};
+
+#endif // CONTACT_H_INCLUDED
@@ -0,0 +1,58 @@
+#ifndef ENTITYHANDLE_H_INCLUDED
+#define ENTITYHANDLE_H_INCLUDED
+
+#include <stdint.h>
+
+enum EntityType
+{
+	ENTITY_TYPE_NONE = 0,
+	ENTITY_TYPE_PLAYER,
+	ENTITY_TYPE_ENEMY,
+	ENTITY_TYPE_ASTEROID,
+	ENTITY_TYPE_BULLET,
+
+	ENTITY_TYPE_COUNT
+};
+
+// Refers to an entity by registry slot plus the generation the slot had when
+// the handle was issued, so a handle to a destroyed entity can be detected
+// even after its slot has been reused.
+struct EntityHandle
+{
+	EntityHandle() :
+		index(INVALID_INDEX),
+		generation(0)
+	{
+	}
+
+	EntityHandle(uint32_t slotIndex, uint32_t slotGeneration) :
+		index(slotIndex),
+		generation(slotGeneration)
+	{
+	}
+
+	bool IsValid() const
+	{
+		return index != INVALID_INDEX;
+	}
+
+	bool operator==(const EntityHandle &other) const
+	{
+		return index == other.index && generation == other.generation;
+	}
+
+	bool operator!=(const EntityHandle &other) const
+	{
+		return !(*this == other);
+	}
+
+	enum { INVALID_INDEX = 0xffffffff };
+
+	uint32_t index;
+	uint32_t generation;
+};
+
+// Colliders are named the same way, by their slot in Collision
+typedef EntityHandle ColliderHandle;
+
+#endif // ENTITYHANDLE_H_INCLUDED
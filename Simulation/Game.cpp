@@ -0,0 +1,989 @@
+#include "Game.h"
+#include "Ship.h"
+#include "UFO.h"
+#include "Random.h"
+#include "Maths.h"
+#include "Collision.h"
+#include "Collider.h"
+#include "MotionKernels.h"
+#include "TaskGraph.h"
+#include <algorithm>
+
+namespace
+{
+	const WorldBounds WORLD_BOUNDS = { -400.0f, 400.0f, -300.0f, 300.0f };
+}
+
+Game::Game(JobSystem *jobs, PoolOverflowPolicy overflowPolicy, unsigned int numPatterns) :
+	jobs_(jobs),
+	updateGraph_(nullptr),
+	tickInput_(nullptr),
+	player_(nullptr),
+	enemy_(nullptr),
+	world_(overflowPolicy),
+	commands_(World::MAX_ASTEROIDS + World::MAX_BULLETS),
+	collision_(nullptr),
+	patterns_(numPatterns),
+	nextExplosionSeed_(0),
+	random_(Random::DEFAULT_SEED),
+	score_(0),
+	pendingFireMode_(GameInput::FIRE_MODE_UNCHANGED)
+{
+	const unsigned int MAX_SHIPS = 2;
+	collision_ = new Collision(World::MAX_ASTEROIDS + World::MAX_BULLETS + MAX_SHIPS, overflowPolicy, WORLD_BOUNDS, jobs_);
+	scorePopups_.reserve(World::MAX_ASTEROIDS);
+	SetupCollisionLayers();
+	BuildExplosionEmitters();
+
+	updateGraph_ = new TaskGraph();
+	BuildUpdateGraph();
+}
+
+Game::~Game()
+{
+	delete player_;
+	delete enemy_;
+	DeleteAllBullets();
+	DeleteAllAsteroids();
+	DeleteAllExplosions();
+	delete collision_;
+	delete updateGraph_;
+}
+
+unsigned int Game::Advance(double realSeconds, const GameInput &input)
+{
+	unsigned int ticks = clock_.Accumulate(realSeconds);
+
+	if (ticks == 0)
+	{
+		//Hold on to a mode change until a tick gets to see it
+		if (input.fireMode != GameInput::FIRE_MODE_UNCHANGED)
+			pendingFireMode_ = input.fireMode;
+		return 0;
+	}
+
+	GameInput tickInput = input;
+	if (tickInput.fireMode == GameInput::FIRE_MODE_UNCHANGED)
+		tickInput.fireMode = pendingFireMode_;
+	pendingFireMode_ = GameInput::FIRE_MODE_UNCHANGED;
+
+	for (unsigned int tick = 0; tick < ticks; ++tick)
+	{
+		Update(tickInput);
+		tickInput.fireMode = GameInput::FIRE_MODE_UNCHANGED;
+	}
+
+	return ticks;
+}
+
+void Game::Update(const GameInput &input)
+{
+	tickInput_ = &input;
+	updateGraph_->Run(jobs_);
+	tickInput_ = nullptr;
+
+	clock_.Tick();
+}
+
+void Game::SetupCollisionLayers()
+{
+	// Only the pairs DoCollision does something with
+	for (unsigned int a = 0; a < COLLISION_LAYER_COUNT; ++a)
+	{
+		for (unsigned int b = a; b < COLLISION_LAYER_COUNT; ++b)
+		{
+			collision_->SetLayersCollide(static_cast<CollisionLayer>(a), static_cast<CollisionLayer>(b), false);
+		}
+	}
+
+	collision_->SetLayersCollide(COLLISION_LAYER_PLAYER, COLLISION_LAYER_ASTEROID, true);
+	collision_->SetLayersCollide(COLLISION_LAYER_PLAYER, COLLISION_LAYER_ENEMY, true);
+	collision_->SetLayersCollide(COLLISION_LAYER_PLAYER, COLLISION_LAYER_ENEMY_BULLET, true);
+	collision_->SetLayersCollide(COLLISION_LAYER_ENEMY, COLLISION_LAYER_PLAYER_BULLET, true);
+	collision_->SetLayersCollide(COLLISION_LAYER_ASTEROID, COLLISION_LAYER_PLAYER_BULLET, true);
+}
+
+void Game::BuildUpdateGraph()
+{
+	// Ships first; they spawn bullets. Then the single point where queued
+	// commands are applied, after which asteroids, bullets and explosions
+	// only touch their own arrays and move together.
+	TaskGraph::TaskId input = updateGraph_->AddTask([this]() { UpdatePlayer(*tickInput_); });
+	TaskGraph::TaskId ai = updateGraph_->AddTask([this]() { UpdateEnemy(); });
+	TaskGraph::TaskId structural = updateGraph_->AddTask([this]() { ApplyStructuralChanges(); });
+	TaskGraph::TaskId asteroids = updateGraph_->AddTask([this]() { UpdateAsteroids(); });
+	TaskGraph::TaskId bullets = updateGraph_->AddTask([this]() { UpdateBullets(); });
+	TaskGraph::TaskId explosions = updateGraph_->AddTask([this]() { UpdateExplosions(); });
+	TaskGraph::TaskId collisions = updateGraph_->AddTask([this]() { UpdateCollisions(); });
+	TaskGraph::TaskId popups = updateGraph_->AddTask([this]() { UpdatePopups(); });
+
+	updateGraph_->AddDependency(input, ai);
+	updateGraph_->AddDependency(ai, structural);
+	updateGraph_->AddDependency(structural, asteroids);
+	updateGraph_->AddDependency(structural, bullets);
+	updateGraph_->AddDependency(structural, explosions);
+	updateGraph_->AddDependency(asteroids, collisions);
+	updateGraph_->AddDependency(bullets, collisions);
+	updateGraph_->AddDependency(explosions, collisions);
+	updateGraph_->AddDependency(collisions, popups);
+}
+
+void Game::UpdatePopups()
+{
+	float deltaTime = clock_.GetTickSeconds();
+	float stepScale = clock_.GetStepScale();
+
+	unsigned int index = 0;
+	while (index < scorePopups_.size())
+	{
+		Score &popup = scorePopups_[index];
+		if (popup.life > 2.f)
+		{
+			popup = scorePopups_.back();
+			scorePopups_.pop_back();
+		}
+		else
+		{
+			popup.life += deltaTime;
+			popup.pos.y -= 0.5f * stepScale;
+			popup.color = XMVectorSetW(popup.color, 1 - popup.life / 2.f);
+			++index;
+		}
+	}
+}
+
+void Game::InitialiseLevel(int numAsteroids)
+{
+	clock_.Reset();
+	pendingFireMode_ = GameInput::FIRE_MODE_UNCHANGED;
+	scorePopups_.clear();
+	ApplyStructuralChanges();
+	DeleteAllAsteroids();
+	DeleteAllExplosions();
+
+	SpawnPlayer();
+	SpawnAsteroids(numAsteroids);
+
+	if (numAsteroids > 2)
+		SpawnEnemy();
+	else if (numAsteroids > 1)
+		SpawnUFOEnemy(numAsteroids);
+
+	ApplyStructuralChanges();
+}
+
+bool Game::IsLevelComplete() const
+{
+	return (world_.asteroids.Size() == 0 && world_.explosions.Size() == 0);
+}
+
+bool Game::IsGameOver() const
+{
+	return (player_ == nullptr && world_.explosions.Size() == 0);
+}
+
+void Game::SpawnEnemy()
+{
+	DeleteEnemy();
+	enemy_ = new Ship();
+	enemy_->SetPosition(XMVectorSet(-350.f, 250.f, 0.f, 0.f));
+	enemy_->SetColor(XMVectorSet(0.f, 0.8f, 0.f, 1.f));
+	enemy_->SetCooldown(2.f);
+	enemy_->EnableCollisions(collision_, 10.0f, ENTITY_TYPE_ENEMY, COLLISION_LAYER_ENEMY);
+}
+
+void Game::SpawnUFOEnemy(int level)
+{
+	DeleteEnemy();
+	enemy_ = new UFO(level);
+	enemy_->EnableCollisions(collision_, 10.0f, ENTITY_TYPE_ENEMY, COLLISION_LAYER_ENEMY);
+}
+
+void Game::DeleteEnemy()
+{
+	if (enemy_)
+	{
+		delete enemy_;
+		enemy_ = nullptr;
+	}
+}
+
+void Game::UpdateEnemy()
+{
+	if (!enemy_ || !player_)
+		return;
+
+	if (enemy_->IsAlive())
+	{
+		XMVECTOR vectorToPlayer = player_->GetPosition() - enemy_->GetPosition();
+
+		//Check if the enemy is a UFO or a ship enemy
+		UFO* ufo = dynamic_cast<UFO*>(enemy_);
+
+		if (ufo)
+		{
+			if (ufo->ReadyToShoot())
+			{
+				vectorToPlayer = XMVector3Normalize(vectorToPlayer);
+				XMVECTOR bulletPosition = ufo->GetPosition() + vectorToPlayer * 10.0f;
+				SpawnBullet(Enemy, bulletPosition, vectorToPlayer, 3.f);
+				ufo->DisableShooting();
+			}
+
+			ufo->Update(clock_);
+			WrapEntity(ufo);
+		}
+		else
+		{
+			//Move Towards player
+			float acceleration = 0.f;
+
+			if (XMVectorGetX(XMVector3LengthSq(vectorToPlayer)) > 30000.f)
+			{
+				//Player not in range, so move closer
+				acceleration = 0.7f;
+			}
+			else if (enemy_->ReadyToShoot())
+			{
+				//Player in range, shoot
+				XMVECTOR enemyForward = enemy_->GetForwardVector();
+				XMVECTOR bulletPosition = enemy_->GetPosition() + enemyForward * 10.0f;
+				SpawnBullet(Enemy, bulletPosition, enemyForward, 4.f);
+				enemy_->DisableShooting();
+			}
+
+			vectorToPlayer = XMVector3Normalize(vectorToPlayer);
+
+			//Look Towards player
+			float rotation = 0.f;
+
+			XMVECTOR rightVector;
+			rightVector = XMVector3Cross(enemy_->GetForwardVector(), XMVectorSet(0.f, 0.f, -1.f, 0.f));
+
+			float dotProduct = XMVectorGetX(XMVector3Dot(rightVector, vectorToPlayer));
+			float angleToPlayer = (acos(dotProduct) * 180.f / Maths::PI);
+
+			if (angleToPlayer > 2.f)
+			{
+				if (dotProduct < 0)
+					rotation = -1.f;
+				else
+					rotation = 1.f;
+			}
+
+			enemy_->SetControlInput(acceleration, rotation);
+			enemy_->Update(clock_);
+			WrapEntity(enemy_);
+		}
+	}
+	else
+		DeleteEnemy();
+}
+
+void Game::SpawnPlayer()
+{
+	DeletePlayer();
+	player_ = new Ship();
+	player_->SetCooldown(0.7f);
+	player_->EnableCollisions(collision_, 10.0f, ENTITY_TYPE_PLAYER, COLLISION_LAYER_PLAYER);
+	player_->SetNumLives(3);
+}
+
+void Game::DeletePlayer()
+{
+	delete player_;
+	player_ = nullptr;
+}
+
+void Game::UpdatePlayer(const GameInput &input)
+{
+	if (!player_)
+		return;
+
+	if (player_->IsAlive())
+	{
+		switch (input.fireMode)
+		{
+		case GameInput::FIRE_MODE_SINGLE:
+			player_->SetFireMode(Ship::FireMode::SINGLE);
+			player_->SetCooldown(0.7f);
+			break;
+		case GameInput::FIRE_MODE_SINGLE_FAST:
+			player_->SetFireMode(Ship::FireMode::SINGLE_FAST);
+			player_->SetCooldown(0.1f);
+			break;
+		case GameInput::FIRE_MODE_SCATTER:
+			player_->SetFireMode(Ship::FireMode::SCATTER);
+			player_->SetCooldown(1.0f);
+			break;
+		default:
+			break;
+		}
+
+		player_->SetControlInput(input.acceleration, input.rotation);
+		player_->Update(clock_);
+		WrapEntity(player_);
+
+		if (input.fire && player_->ReadyToShoot())
+		{
+			XMVECTOR playerForward = player_->GetForwardVector();
+			XMVECTOR bulletPosition = player_->GetPosition() + playerForward * 10.0f;
+
+			if (player_->GetFireMode() == Ship::FireMode::SCATTER)
+			{
+				XMVECTOR axis = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+				SpawnBullet(Owner::Player, bulletPosition, playerForward, 1.0f);
+				SpawnBullet(Owner::Player, bulletPosition, XMVector3Rotate(playerForward, XMQuaternionRotationAxis(axis, 5 * Maths::PI / 180)), 1.0f);
+				SpawnBullet(Owner::Player, bulletPosition, XMVector3Rotate(playerForward, XMQuaternionRotationAxis(axis, 10 * Maths::PI / 180)), 1.0f);
+				SpawnBullet(Owner::Player, bulletPosition, XMVector3Rotate(playerForward, XMQuaternionRotationAxis(axis, -5 * Maths::PI / 180)), 1.0f);
+				SpawnBullet(Owner::Player, bulletPosition, XMVector3Rotate(playerForward, XMQuaternionRotationAxis(axis, -10 * Maths::PI / 180)), 1.0f);
+			}
+			else if(player_->GetFireMode() == Ship::FireMode::SINGLE_FAST)
+			{
+				SpawnBullet(Owner::Player, bulletPosition, playerForward, 1.0f);
+			}
+			else
+			{
+				SpawnBullet(Owner::Player, bulletPosition, playerForward, 2.5f);
+			}
+
+			player_->DisableShooting();
+		}
+	}
+	else
+	{
+		DeletePlayer();
+	}
+}
+
+void Game::ApplyStructuralChanges()
+{
+	commands_.Sort();
+
+	for (unsigned int commandIndex = 0; commandIndex < commands_.Size(); ++commandIndex)
+	{
+		const CommandBuffer::Command &command = commands_.GetCommand(commandIndex);
+		switch (command.type)
+		{
+		case CommandBuffer::COMMAND_KILL:
+			KillEntity(command.entityType, command.handle);
+			break;
+		case CommandBuffer::COMMAND_SPAWN_ASTEROID:
+			CreateAsteroid(command.position, command.size);
+			break;
+		case CommandBuffer::COMMAND_SPAWN_EXPLOSION:
+			CreateExplosion(command.position, command.size);
+			break;
+		case CommandBuffer::COMMAND_SPAWN_BULLET:
+			CreateBullet(command.owner, command.position, command.velocity, command.lifeTime);
+			break;
+		}
+	}
+	commands_.Clear();
+
+	RemoveDeadEntities();
+	collision_->ApplyPendingChanges();
+}
+
+void Game::KillEntity(EntityType type, EntityHandle handle)
+{
+	unsigned int index = 0;
+	switch (type)
+	{
+	case ENTITY_TYPE_ASTEROID:
+		if (world_.asteroids.handles.Resolve(handle, &index))
+			world_.asteroids.alive[index] = 0;
+		break;
+	case ENTITY_TYPE_BULLET:
+		if (world_.bullets.handles.Resolve(handle, &index))
+			world_.bullets.alive[index] = 0;
+		break;
+	default:
+		break;
+	}
+}
+
+void Game::RemoveDeadEntities()
+{
+	World::AsteroidArrays &asteroids = world_.asteroids;
+	unsigned int index = 0;
+	while (index < asteroids.Size())
+	{
+		if (!asteroids.alive[index])
+			DeleteAsteroid(index);
+		else
+			++index;
+	}
+
+	World::ExplosionArrays &explosions = world_.explosions;
+	index = 0;
+	while (index < explosions.Size())
+	{
+		if (!explosions.alive[index])
+			DeleteExplosion(index);
+		else
+			++index;
+	}
+
+	World::BulletArrays &bullets = world_.bullets;
+	index = 0;
+	while (index < bullets.Size())
+	{
+		if (!bullets.alive[index])
+			DeleteBullet(index);
+		else
+			++index;
+	}
+}
+
+void Game::UpdateAsteroids()
+{
+	const unsigned int GRAIN_SIZE = 256;
+
+	ParallelFor(world_.asteroids.Size(), GRAIN_SIZE, [this](unsigned int begin, unsigned int end)
+	{
+		World::AsteroidArrays &asteroids = world_.asteroids;
+		float stepScale = clock_.GetStepScale();
+		unsigned int count = end - begin;
+
+		MotionKernels::IntegrateWrap(&asteroids.positionX[begin], &asteroids.velocityX[begin], stepScale, count, WORLD_BOUNDS.minX, WORLD_BOUNDS.maxX);
+		MotionKernels::IntegrateWrap(&asteroids.positionY[begin], &asteroids.velocityY[begin], stepScale, count, WORLD_BOUNDS.minY, WORLD_BOUNDS.maxY);
+		MotionKernels::IntegrateWrap(&asteroids.angle[begin], &asteroids.angularSpeed[begin], stepScale, count, 0.0f, Maths::TWO_PI);
+
+		for (unsigned int index = begin; index < end; ++index)
+		{
+			collision_->UpdateColliderPosition(asteroids.collider[index],
+				XMFLOAT3(asteroids.positionX[index], asteroids.positionY[index], 0.0f));
+		}
+	});
+}
+
+void Game::UpdateBullets()
+{
+	const unsigned int GRAIN_SIZE = 256;
+
+	ParallelFor(world_.bullets.Size(), GRAIN_SIZE, [this](unsigned int begin, unsigned int end)
+	{
+		World::BulletArrays &bullets = world_.bullets;
+		float deltaTime = clock_.GetTickSeconds();
+		float stepScale = clock_.GetStepScale();
+		unsigned int count = end - begin;
+
+		for (unsigned int index = begin; index < end; ++index)
+		{
+			bullets.age[index] += deltaTime;
+			if (bullets.age[index] > bullets.lifeTime[index])
+			{
+				bullets.alive[index] = 0;
+			}
+		}
+
+		MotionKernels::IntegrateWrap(&bullets.positionX[begin], &bullets.velocityX[begin], stepScale, count, WORLD_BOUNDS.minX, WORLD_BOUNDS.maxX);
+		MotionKernels::IntegrateWrap(&bullets.positionY[begin], &bullets.velocityY[begin], stepScale, count, WORLD_BOUNDS.minY, WORLD_BOUNDS.maxY);
+
+		for (unsigned int index = begin; index < end; ++index)
+		{
+			collision_->UpdateColliderPosition(bullets.collider[index],
+				XMFLOAT3(bullets.positionX[index], bullets.positionY[index], 0.0f));
+		}
+	});
+}
+
+void Game::UpdateExplosions()
+{
+	World::ExplosionArrays &explosions = world_.explosions;
+	const ParticleSystem &particles = world_.particles;
+
+	//As of the end of this tick
+	double time = clock_.GetTime() + clock_.GetTickSeconds();
+	for (unsigned int index = 0; index < explosions.Size(); ++index)
+	{
+		if (particles.IsEmitterFinished(explosions.emitter[index], time))
+		{
+			explosions.alive[index] = 0;
+		}
+	}
+}
+
+void Game::ParallelFor(unsigned int count, unsigned int grainSize,
+	const JobSystem::RangeFunction &function)
+{
+	if (jobs_)
+	{
+		jobs_->ParallelFor(count, grainSize, function);
+	}
+	else if (count > 0)
+	{
+		function(0, count);
+	}
+}
+
+void Game::WrapEntity(GameEntity *entity) const
+{
+	XMFLOAT3 entityPosition;
+	XMStoreFloat3(&entityPosition, entity->GetPosition());
+	WrapPosition(&entityPosition.x, &entityPosition.y);
+	entity->SetPosition(XMLoadFloat3(&entityPosition));
+}
+
+void Game::WrapPosition(float *x, float *y)
+{
+	*x = MotionKernels::WrapValue(*x, WORLD_BOUNDS.minX, WORLD_BOUNDS.maxX);
+	*y = MotionKernels::WrapValue(*y, WORLD_BOUNDS.minY, WORLD_BOUNDS.maxY);
+}
+
+void Game::DeleteAllBullets()
+{
+	World::BulletArrays &bullets = world_.bullets;
+	for (unsigned int index = 0; index < bullets.Size(); ++index)
+	{
+		collision_->DestroyCollider(bullets.collider[index]);
+	}
+
+	bullets.Clear();
+}
+
+void Game::DeleteAllAsteroids()
+{
+	World::AsteroidArrays &asteroids = world_.asteroids;
+	for (unsigned int index = 0; index < asteroids.Size(); ++index)
+	{
+		collision_->DestroyCollider(asteroids.collider[index]);
+	}
+
+	asteroids.Clear();
+}
+
+void Game::DeleteAllExplosions()
+{
+	world_.explosions.Clear();
+	world_.particles.Clear();
+}
+
+void Game::SpawnBullet(Owner owner, const XMVECTOR& position,
+	const XMVECTOR& direction, const float life)
+{
+	const float BULLET_SPEED = 4.0f;
+
+	XMFLOAT2 bulletPosition;
+	XMStoreFloat2(&bulletPosition, position);
+	XMFLOAT2 velocity;
+	XMStoreFloat2(&velocity, XMVector3Normalize(direction) * BULLET_SPEED);
+
+	commands_.SpawnBullet(owner, bulletPosition, velocity, life);
+}
+
+void Game::CreateBullet(Owner owner, const XMFLOAT2 &position,
+	const XMFLOAT2 &velocity, float life)
+{
+	World::BulletArrays &bullets = world_.bullets;
+	if (!bullets.CanAdd() || !collision_->CanCreateCollider())
+		return;
+
+	unsigned int index = bullets.Add(owner,
+		position.x, position.y,
+		velocity.x, velocity.y,
+		life);
+
+	CollisionLayer layer = owner == Player ? COLLISION_LAYER_PLAYER_BULLET : COLLISION_LAYER_ENEMY_BULLET;
+	ColliderHandle collider = collision_->CreateCollider(ENTITY_TYPE_BULLET, bullets.handle[index], layer);
+	collision_->UpdateColliderPosition(collider, XMFLOAT3(position.x, position.y, 0.0f));
+	collision_->UpdateColliderRadius(collider, 3.0f);
+	collision_->SetColliderSwept(collider, true);
+	bullets.collider[index] = collider;
+}
+
+bool Game::FindBullet(const Collider *collider, unsigned int *index) const
+{
+	if (collider->GetEntityType() != ENTITY_TYPE_BULLET)
+		return false;
+
+	return world_.bullets.handles.Resolve(collider->GetEntityHandle(), index);
+}
+
+void Game::DeleteBullet(unsigned int index)
+{
+	collision_->DestroyCollider(world_.bullets.collider[index]);
+	world_.bullets.Remove(index);
+}
+
+void Game::DeleteExplosion(unsigned int index)
+{
+	world_.particles.DestroyEmitter(world_.explosions.emitter[index]);
+	world_.explosions.Remove(index);
+}
+
+void Game::SpawnAsteroids(int numAsteroids)
+{
+	float halfWidth = 800.0f * 0.5f;
+	float halfHeight = 600.0f * 0.5f;
+	for (int i = 0; i < numAsteroids; i++)
+	{
+		float x = random_.NextFloat(-halfWidth, halfWidth);
+		float y = random_.NextFloat(-halfHeight, halfHeight);
+		XMVECTOR position = XMVectorSet(x, y, 0.0f, 0.0f);
+		SpawnAsteroidAt(position, 3);
+	}
+}
+
+void Game::SpawnAsteroidAt(XMVECTOR position, int size)
+{
+	XMFLOAT2 asteroidPosition;
+	XMStoreFloat2(&asteroidPosition, position);
+	commands_.SpawnAsteroid(asteroidPosition, size);
+}
+
+void Game::CreateAsteroid(const XMFLOAT2 &position, int size)
+{
+	if (!world_.asteroids.CanAdd() || !collision_->CanCreateCollider())
+		return;
+
+	const float MAX_ASTEROID_SPEED = 1.0f;
+	const float MAX_ROTATION = 0.3f;
+
+	float angle = random_.NextFloat(Maths::TWO_PI);
+	XMMATRIX randomRotation = XMMatrixRotationZ(angle);
+	XMVECTOR velocity = XMVectorSet(0.0f, random_.NextFloat(MAX_ASTEROID_SPEED), 0.0f, 0.0f);
+	velocity = XMVector3TransformNormal(velocity, randomRotation);
+
+	XMFLOAT3 axis;
+	axis.x = random_.NextFloat(-1.0f, 1.0f);
+	axis.y = random_.NextFloat(-1.0f, 1.0f);
+	axis.z = random_.NextFloat(-1.0f, 1.0f);
+	XMStoreFloat3(&axis, XMVector3Normalize(XMLoadFloat3(&axis)));
+
+	float angularSpeed = random_.NextFloat(-MAX_ROTATION, MAX_ROTATION);
+
+	World::AsteroidArrays &asteroids = world_.asteroids;
+	unsigned int index = asteroids.Add(position.x, position.y,
+		XMVectorGetX(velocity), XMVectorGetY(velocity),
+		axis,
+		angularSpeed,
+		size);
+
+	ColliderHandle collider = collision_->CreateCollider(ENTITY_TYPE_ASTEROID, asteroids.handle[index], COLLISION_LAYER_ASTEROID);
+	collision_->UpdateColliderPosition(collider, XMFLOAT3(position.x, position.y, 0.0f));
+	collision_->UpdateColliderRadius(collider, size * 5.0f);
+	collision_->SetColliderSwept(collider, true);
+	asteroids.collider[index] = collider;
+}
+
+bool Game::FindAsteroid(const Collider *collider, unsigned int *index) const
+{
+	if (collider->GetEntityType() != ENTITY_TYPE_ASTEROID)
+		return false;
+
+	return world_.asteroids.handles.Resolve(collider->GetEntityHandle(), index);
+}
+
+void Game::AsteroidHit(unsigned int index)
+{
+	World::AsteroidArrays &asteroids = world_.asteroids;
+	int oldSize = asteroids.size[index];
+	XMVECTOR position = XMVectorSet(asteroids.positionX[index], asteroids.positionY[index], 0.0f, 0.0f);
+
+	SpawnExplosionAt(position, oldSize);
+
+	if (oldSize > 1)
+	{
+		int smallerSize = oldSize -1;
+		SpawnAsteroidAt(position, smallerSize);
+		SpawnAsteroidAt(position, smallerSize);
+	}
+	commands_.Kill(ENTITY_TYPE_ASTEROID, asteroids.handle[index]);
+}
+
+void Game::DeleteAsteroid(unsigned int index)
+{
+	collision_->DestroyCollider(world_.asteroids.collider[index]);
+	world_.asteroids.Remove(index);
+}
+
+void Game::SpawnExplosionAt(const XMVECTOR& position, int size)
+{
+	XMFLOAT2 explosionPosition;
+	XMStoreFloat2(&explosionPosition, position);
+	commands_.SpawnExplosion(explosionPosition, size);
+}
+
+void Game::BuildExplosionEmitters()
+{
+	const float EXPLOSION_START_SPEED = 5.f;
+	const float WAVE_SPEED = 3.f;
+	const unsigned int WAVE_PARTICLES = 20;
+	const float WAVE_SPACING = 0.2f;
+	const float EXPLOSION_ACTIVE_TIME = 10.f;
+
+	//Explosions step by their total age, not the tick length. Run that clock
+	//once to find the ages at which waves of particles come out and when it
+	//stops, which are the same for every explosion
+	float tickSeconds = clock_.GetTickSeconds();
+	std::vector<float> waveAges;
+	float age = 0.f;
+	float activeTime = 0.f;
+	float lastSpawnTime = 0.f;
+	unsigned int ticks = 0;
+	do
+	{
+		++ticks;
+		age += tickSeconds;
+		activeTime += age;
+
+		//A new wave every 0.2s of active time
+		if (activeTime - lastSpawnTime > WAVE_SPACING)
+		{
+			waveAges.push_back((ticks - 1) * tickSeconds);
+			lastSpawnTime = activeTime;
+		}
+	} while (activeTime <= EXPLOSION_ACTIVE_TIME);
+
+	for (int size = 0; size <= MAX_EXPLOSION_SIZE; ++size)
+	{
+		std::vector<ParticleWave> &waves = explosionWaves_[size];
+		waves.clear();
+
+		ParticleWave firstWave = { 0.f, 50u + size * 5u, EXPLOSION_START_SPEED, static_cast<float>(size), 2.f };
+		waves.push_back(firstWave);
+		for (std::vector<float>::const_iterator ageIt = waveAges.begin(), end = waveAges.end();
+			ageIt != end;
+			++ageIt)
+		{
+			ParticleWave wave = { *ageIt, WAVE_PARTICLES, WAVE_SPEED, 0.f, 2.f };
+			waves.push_back(wave);
+		}
+
+		AnalyticEmitterDesc &desc = explosionEmitters_[size];
+		desc.patterns = &patterns_;
+		desc.waves = waves.data();
+		desc.numWaves = static_cast<unsigned int>(waves.size());
+		desc.tickSeconds = tickSeconds;
+		//Halfway into the last tick, so rounding in the clock cannot move it
+		desc.duration = (ticks - 0.5f) * tickSeconds;
+	}
+}
+
+void Game::CreateExplosion(const XMFLOAT2 &position, int size)
+{
+	World::ExplosionArrays &explosions = world_.explosions;
+	if (!explosions.CanAdd())
+		return;
+
+	//Nothing is stored per particle; they are worked out when drawn
+	size = std::min(std::max(size, 0), MAX_EXPLOSION_SIZE);
+	unsigned int emitter = world_.particles.CreateAnalyticEmitter(position.x, position.y,
+		Random::Hash(nextExplosionSeed_++),
+		clock_.GetTime(),
+		&explosionEmitters_[size]);
+	explosions.Add(position.x, position.y, emitter);
+}
+
+void Game::UpdateCollisions()
+{
+	collision_->FindContacts();
+
+	unsigned int count = 0;
+	const Contact *contacts = collision_->GetContacts(CONTACT_SHIP_ASTEROID, &count);
+	HandleShipAsteroidContacts(contacts, count);
+
+	contacts = collision_->GetContacts(CONTACT_SHIP_SHIP, &count);
+	HandleShipShipContacts(contacts, count);
+
+	contacts = collision_->GetContacts(CONTACT_BULLET_ASTEROID, &count);
+	HandleBulletAsteroidContacts(contacts, count);
+
+	contacts = collision_->GetContacts(CONTACT_BULLET_SHIP, &count);
+	HandleBulletShipContacts(contacts, count);
+}
+
+void Game::HandleShipAsteroidContacts(const Contact *contacts, unsigned int count)
+{
+	for (unsigned int contact = 0; contact < count; ++contact)
+	{
+		// Only the player is hurt by asteroids
+		unsigned int asteroidIndex;
+		if (player_ == nullptr || contacts[contact].first.GetEntityType() != ENTITY_TYPE_PLAYER ||
+			!FindAsteroid(&contacts[contact].second, &asteroidIndex))
+			continue;
+
+		AsteroidHit(asteroidIndex);
+
+		player_->TakeLife();
+	}
+}
+
+void Game::HandleShipShipContacts(const Contact *contacts, unsigned int count)
+{
+	for (unsigned int contact = 0; contact < count; ++contact)
+	{
+		Ship *first = FindShip(contacts[contact].first);
+		Ship *second = FindShip(contacts[contact].second);
+		if (first == nullptr || second == nullptr || first == second)
+			continue;
+
+		first->TakeLife();
+		SpawnExplosionAt(first->GetPosition(), 3);
+		second->TakeLife();
+		SpawnExplosionAt(second->GetPosition(), 3);
+	}
+}
+
+void Game::HandleBulletAsteroidContacts(const Contact *contacts, unsigned int count)
+{
+	World::BulletArrays &bullets = world_.bullets;
+	World::AsteroidArrays &asteroids = world_.asteroids;
+
+	for (unsigned int contact = 0; contact < count; ++contact)
+	{
+		unsigned int bulletIndex;
+		unsigned int asteroidIndex;
+		if (!FindBullet(&contacts[contact].first, &bulletIndex) ||
+			!FindAsteroid(&contacts[contact].second, &asteroidIndex))
+			continue;
+
+		if (bullets.owner[bulletIndex] != Player)
+			continue;
+
+		float asteroidX = asteroids.positionX[asteroidIndex];
+		float asteroidY = asteroids.positionY[asteroidIndex];
+		int asteroidSize = asteroids.size[asteroidIndex];
+
+		AsteroidHit(asteroidIndex);
+		commands_.Kill(ENTITY_TYPE_BULLET, bullets.handle[bulletIndex]);
+
+		Score newScore;
+
+		newScore.color = XMVectorSet(1.0f, 0.0f, 0.0f, 1.0f);
+
+		newScore.life = 0;
+		//Convert asteroid position to screen space
+		newScore.pos.x = asteroidX + 400;
+		newScore.pos.y = -(asteroidY - 300);
+		switch (asteroidSize)
+		{
+		case 1: score_ += 50;
+			newScore.value = 50;
+			break;
+		case 2: score_ += 20;
+			newScore.value = 20;
+			break;
+		case 3: score_ += 10;
+			newScore.value = 10;
+			break;
+		default:
+			break;
+		}
+		scorePopups_.push_back(newScore);
+	}
+}
+
+void Game::HandleBulletShipContacts(const Contact *contacts, unsigned int count)
+{
+	World::BulletArrays &bullets = world_.bullets;
+
+	for (unsigned int contact = 0; contact < count; ++contact)
+	{
+		unsigned int bulletIndex;
+		Ship *ship = FindShip(contacts[contact].second);
+		if (ship == nullptr || !FindBullet(&contacts[contact].first, &bulletIndex))
+			continue;
+
+		// Ships are only hurt by the other side's bullets
+		Owner bulletOwner = bullets.owner[bulletIndex];
+		if ((ship == enemy_ && bulletOwner != Player) || (ship == player_ && bulletOwner != Enemy))
+			continue;
+
+		ship->TakeLife();
+		commands_.Kill(ENTITY_TYPE_BULLET, bullets.handle[bulletIndex]);
+		SpawnExplosionAt(ship->GetPosition(), 3);
+	}
+}
+
+Ship *Game::FindShip(const Collider &collider) const
+{
+	switch (collider.GetEntityType())
+	{
+	case ENTITY_TYPE_PLAYER: return player_;
+	case ENTITY_TYPE_ENEMY: return enemy_;
+	default: return nullptr;
+	}
+}
+
+int Game::GetScore() const
+{
+	return score_;
+}
+
+const std::vector<Game::Score>& Game::GetPopups() const
+{
+	return scorePopups_;
+}
+
+const Ship *Game::GetPlayer() const
+{
+	return player_;
+}
+
+const Ship *Game::GetEnemy() const
+{
+	return enemy_;
+}
+
+const World &Game::GetWorld() const
+{
+	return world_;
+}
+
+const SimClock &Game::GetClock() const
+{
+	return clock_;
+}
+
+const PatternBank &Game::GetPatternBank() const
+{
+	return patterns_;
+}
+
+float Game::GetInterpolationAlpha() const
+{
+	return clock_.GetInterpolationAlpha();
+}
+
+const PoolStats &Game::GetColliderPoolStats() const
+{
+	return collision_->GetColliderPoolStats();
+}
+
+void Game::SetBroadphase(BroadphaseType type)
+{
+	collision_->SetBroadphase(type);
+}
+
+void Game::SetTickRate(float ticksPerSecond)
+{
+	clock_.SetTickSeconds(1.0f / ticksPerSecond);
+	DeleteAllExplosions();
+	BuildExplosionEmitters();
+}
+
+float Game::GetTickRate() const
+{
+	return 1.0f / clock_.GetTickSeconds();
+}
+
+void Game::SetRandomSeed(uint64_t seed)
+{
+	random_.Seed(seed);
+}
+
+void Game::ResetGame()
+{
+	score_ = 0;
+	scorePopups_.clear();
+	DeletePlayer();
+	DeleteEnemy();
+	DeleteAllBullets();
+	DeleteAllAsteroids();
+	DeleteAllExplosions();
+	commands_.Clear();
+	collision_->ApplyPendingChanges();
+}
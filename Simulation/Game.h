@@ -0,0 +1,160 @@
+#ifndef GAME_H_INCLUDED
+#define GAME_H_INCLUDED
+
+#include <DirectXMath.h>
+#include <vector>
+
+#include "World.h"
+#include "GameInput.h"
+#include "SimClock.h"
+#include "JobSystem.h"
+#include "CommandBuffer.h"
+#include "Broadphase.h"
+#include "Random.h"
+
+using namespace DirectX;
+
+class Ship;
+class Collision;
+class Collider;
+struct Contact;
+class GameEntity;
+class TaskGraph;
+
+class Game
+{
+public:
+	struct Score
+	{
+		int value;
+		XMFLOAT2 pos;
+		float life;
+		XMVECTOR color;
+	};
+
+	// numPatterns sizes the effect pattern bank; more is more variety
+	explicit Game(JobSystem *jobs = nullptr,
+		PoolOverflowPolicy overflowPolicy = POOL_OVERFLOW_GROW,
+		unsigned int numPatterns = PatternBank::DEFAULT_NUM_PATTERNS);
+	~Game();
+
+	unsigned int Advance(double realSeconds, const GameInput &input);
+	void Update(const GameInput &input);
+
+	void InitialiseLevel(int numAsteroids);
+	bool IsLevelComplete() const;
+	bool IsGameOver() const;
+	int GetScore() const;
+	const std::vector<Score>& GetPopups() const;
+
+	const Ship *GetPlayer() const;
+	const Ship *GetEnemy() const;
+	const World &GetWorld() const;
+	const SimClock &GetClock() const;
+	const PatternBank &GetPatternBank() const;
+	float GetInterpolationAlpha() const;
+	const PoolStats &GetColliderPoolStats() const;
+
+	void SetBroadphase(BroadphaseType type);
+	// Movement is scaled to the tick length, so fewer ticks a second cost
+	// less CPU for the same motion. Meant for between levels: explosions in
+	// flight are dropped and the next InitialiseLevel restarts the clock.
+	void SetTickRate(float ticksPerSecond);
+	float GetTickRate() const;
+	// Asteroid layouts follow from the seed, so runs with the same seed and
+	// input play out the same
+	void SetRandomSeed(uint64_t seed);
+
+	void ResetGame();
+
+private:
+	Game(const Game &);
+	void operator=(const Game &);
+
+	void SpawnPlayer();
+	void DeletePlayer();
+	void UpdatePlayer(const GameInput &input);
+
+	void SpawnEnemy();
+	void SpawnUFOEnemy(int level);
+	void DeleteEnemy();
+	void UpdateEnemy();
+
+	void UpdatePopups();
+
+	void BuildUpdateGraph();
+	void SetupCollisionLayers();
+	void ParallelFor(unsigned int count, unsigned int grainSize,
+		const JobSystem::RangeFunction &function);
+	void ApplyStructuralChanges();
+	void KillEntity(EntityType type, EntityHandle handle);
+	void RemoveDeadEntities();
+
+	void UpdateAsteroids();
+	void UpdateBullets();
+	void UpdateExplosions();
+	void WrapEntity(GameEntity *entity) const;
+	static void WrapPosition(float *x, float *y);
+
+	void DeleteAllBullets();
+	void DeleteAllAsteroids();
+	void DeleteAllExplosions();
+
+	void SpawnBullet(Owner owner, const XMVECTOR &position,
+		const XMVECTOR &direction, const float life);
+	void CreateBullet(Owner owner, const XMFLOAT2 &position,
+		const XMFLOAT2 &velocity, float life);
+	bool FindBullet(const Collider *collider, unsigned int *index) const;
+	void DeleteBullet(unsigned int index);
+
+	void SpawnAsteroids(int numAsteroids);
+	void SpawnAsteroidAt(XMVECTOR position, int size);
+	void CreateAsteroid(const XMFLOAT2 &position, int size);
+	bool FindAsteroid(const Collider *collider, unsigned int *index) const;
+	void AsteroidHit(unsigned int index);
+	void DeleteAsteroid(unsigned int index);
+
+	void BuildExplosionEmitters();
+	void SpawnExplosionAt(const XMVECTOR& position, int size);
+	void CreateExplosion(const XMFLOAT2 &position, int size);
+	void DeleteExplosion(unsigned int index);
+
+	void UpdateCollisions();
+	void HandleShipAsteroidContacts(const Contact *contacts, unsigned int count);
+	void HandleShipShipContacts(const Contact *contacts, unsigned int count);
+	void HandleBulletAsteroidContacts(const Contact *contacts, unsigned int count);
+	void HandleBulletShipContacts(const Contact *contacts, unsigned int count);
+	Ship *FindShip(const Collider &collider) const;
+
+	void ShowScore(const int score, const XMVECTOR& position) const;
+
+	JobSystem *jobs_;
+	TaskGraph *updateGraph_;
+	const GameInput *tickInput_;
+
+	Ship *player_;
+	Ship* enemy_;
+	World world_;
+	CommandBuffer commands_;
+
+	Collision *collision_;
+
+	PatternBank patterns_;
+
+	// One description per explosion size, shared by every explosion's emitter
+	static const int MAX_EXPLOSION_SIZE = 3;
+	std::vector<ParticleWave> explosionWaves_[MAX_EXPLOSION_SIZE + 1];
+	AnalyticEmitterDesc explosionEmitters_[MAX_EXPLOSION_SIZE + 1];
+	uint32_t nextExplosionSeed_;
+
+	// Gameplay's own stream, only drawn from by the structural stage
+	Random random_;
+
+	int score_;
+	std::vector<Score> scorePopups_;
+
+	SimClock clock_;
+	GameInput::FireModeRequest pendingFireMode_;
+};
+
+#endif // GAME_H_INCLUDED
@@ -5,7 +5,7 @@ GameEntity::GameEntity() :
 	isAlive_(true),
 	position_(XMFLOAT3(0.0f, 0.0f, 0.0f)),
 	collisionSystem_(0),
-	collider_(0)
+	collider_()
 {
 }
 
@@ -24,11 +24,7 @@ void GameEntity::SetAlive(bool b)
 	isAlive_ = b;
 }
 
-void GameEntity::Update(System *system)
-{
-}
-
-void GameEntity::Render(Graphics *graphics) const
+void GameEntity::Update(const SimClock &/*clock*/)
 {
 }
 
@@ -46,12 +42,12 @@ void GameEntity::SetPosition(XMVECTOR position)
 	}
 }
 
-void GameEntity::EnableCollisions(Collision *collisionSystem, float radius)
+void GameEntity::EnableCollisions(Collision *collisionSystem, float radius, EntityType type, CollisionLayer layer)
 {
 	DestroyCollider();
 
 	collisionSystem_ = collisionSystem;
-	collider_ = collisionSystem_->CreateCollider(this);
+	collider_ = collisionSystem_->CreateCollider(type, EntityHandle(), layer);
 	collisionSystem_->UpdateColliderPosition(collider_, position_);
 	collisionSystem_->UpdateColliderRadius(collider_, radius);
 }
@@ -63,7 +59,7 @@ void GameEntity::DisableCollisions()
 
 bool GameEntity::HasValidCollider() const
 {
-	return collisionSystem_ && collider_;
+	return collisionSystem_ && collider_.IsValid();
 }
 
 void GameEntity::DestroyCollider()
@@ -74,5 +70,5 @@ void GameEntity::DestroyCollider()
 	}
 
 	collisionSystem_ = 0;
-	collider_ = 0;
+	collider_ = ColliderHandle();
 }
@@ -2,13 +2,13 @@
 #define GAMEENTITY_H_INCLUDED
 
 #include <DirectXMath.h>
+#include "EntityHandle.h"
+#include "CollisionLayer.h"
 
 using namespace DirectX;
 
-class System;
-class Graphics;
 class Collision;
-class Collider;
+class SimClock;
 
 class GameEntity
 {
@@ -16,8 +16,7 @@ public:
 	GameEntity();
 	virtual ~GameEntity();
 
-	virtual void Update(System *system);
-	virtual void Render(Graphics *graphics) const;
+	virtual void Update(const SimClock &clock);
 
 	bool IsAlive() const;
 	void SetAlive(bool b);
@@ -25,7 +24,7 @@ public:
 	XMVECTOR GetPosition() const;
 	void SetPosition(XMVECTOR position);
 
-	void EnableCollisions(Collision *collisionSystem, float radius);
+	void EnableCollisions(Collision *collisionSystem, float radius, EntityType type, CollisionLayer layer);
 	void DisableCollisions();
 
 private:
@@ -36,7 +35,7 @@ private:
 
 	XMFLOAT3 position_;
 	Collision *collisionSystem_;
-	Collider *collider_;
+	ColliderHandle collider_;
 
 };
 
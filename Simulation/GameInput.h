@@ -0,0 +1,30 @@
+#ifndef GAMEINPUT_H_INCLUDED
+#define GAMEINPUT_H_INCLUDED
+
+// Player controls for a single simulation tick. The application fills this in
+// from whatever input devices it has; headless drivers can script it directly.
+struct GameInput
+{
+	enum FireModeRequest
+	{
+		FIRE_MODE_UNCHANGED = -1,
+		FIRE_MODE_SINGLE = 0,
+		FIRE_MODE_SINGLE_FAST,
+		FIRE_MODE_SCATTER
+	};
+
+	GameInput() :
+		acceleration(0.0f),
+		rotation(0.0f),
+		fire(false),
+		fireMode(FIRE_MODE_UNCHANGED)
+	{
+	}
+
+	float acceleration;
+	float rotation;
+	bool fire;
+	FireModeRequest fireMode;
+};
+
+#endif // GAMEINPUT_H_INCLUDED
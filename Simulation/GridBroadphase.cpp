@@ -0,0 +1,153 @@
+#include "GridBroadphase.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const float MIN_CELL_SIZE = 1.0f;
+	const unsigned int MAX_CELLS_PER_AXIS = 128;
+	const unsigned int ROWS_PER_CHUNK = 4;
+
+	unsigned int CellsAlong(float length, float cellSize)
+	{
+		unsigned int cells = static_cast<unsigned int>(length / cellSize);
+		return std::max(1u, std::min(cells, MAX_CELLS_PER_AXIS));
+	}
+
+	unsigned int CellCoordinate(float position, float min, float inverseCellSize, unsigned int cells)
+	{
+		int cell = static_cast<int>(std::floor((position - min) * inverseCellSize));
+		return static_cast<unsigned int>(std::max(0, std::min(cell, static_cast<int>(cells) - 1)));
+	}
+}
+
+GridBroadphase::GridBroadphase() :
+	columns_(1),
+	rows_(1)
+{
+}
+
+void GridBroadphase::FindPairs(const BroadphaseInput &input,
+	JobSystem *jobs,
+	std::vector<ColliderPair> *pairs)
+{
+	BuildGrid(input);
+
+	FindPairsInChunks(jobs, rows_, ROWS_PER_CHUNK,
+		[this, &input](unsigned int beginRow, unsigned int endRow, std::vector<ColliderPair> *rowPairs)
+		{
+			FindPairsInRows(input, beginRow, endRow, rowPairs);
+		},
+		pairs);
+
+	std::sort(pairs->begin(), pairs->end(), ColliderPairLess);
+}
+
+unsigned int GridBroadphase::GetNumCells() const
+{
+	return columns_ * rows_;
+}
+
+void GridBroadphase::BuildGrid(const BroadphaseInput &input)
+{
+	const float *positionX = input.positionX;
+	const float *positionY = input.positionY;
+	const float *radius = input.radius;
+	unsigned int count = input.count;
+	const WorldBounds &bounds = input.bounds;
+
+	float maxRadius = 0.0f;
+	for (unsigned int index = 0; index < count; ++index)
+	{
+		maxRadius = std::max(maxRadius, radius[index]);
+	}
+
+	float cellSize = std::max(2.0f * maxRadius, MIN_CELL_SIZE);
+	columns_ = CellsAlong(bounds.GetWidth(), cellSize);
+	rows_ = CellsAlong(bounds.GetHeight(), cellSize);
+	float inverseCellWidth = columns_ / bounds.GetWidth();
+	float inverseCellHeight = rows_ / bounds.GetHeight();
+
+	// Counting sort of the colliders by cell
+	unsigned int numCells = columns_ * rows_;
+	cellStart_.assign(numCells + 1, 0);
+	cellOf_.resize(count);
+	for (unsigned int index = 0; index < count; ++index)
+	{
+		unsigned int column = CellCoordinate(positionX[index], bounds.minX, inverseCellWidth, columns_);
+		unsigned int row = CellCoordinate(positionY[index], bounds.minY, inverseCellHeight, rows_);
+		unsigned int cell = row * columns_ + column;
+		cellOf_[index] = cell;
+		++cellStart_[cell + 1];
+	}
+
+	for (unsigned int cell = 0; cell < numCells; ++cell)
+	{
+		cellStart_[cell + 1] += cellStart_[cell];
+	}
+
+	cellCursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+	entries_.resize(count);
+	for (unsigned int index = 0; index < count; ++index)
+	{
+		entries_[cellCursor_[cellOf_[index]]++] = index;
+	}
+}
+
+// Pairs between each collider in these rows and anything in the cells
+// around it, found from the lower packed index only
+void GridBroadphase::FindPairsInRows(const BroadphaseInput &input, unsigned int beginRow, unsigned int endRow,
+	std::vector<ColliderPair> *pairs) const
+{
+	unsigned int neighbours[9];
+	for (unsigned int cell = beginRow * columns_; cell < endRow * columns_; ++cell)
+	{
+		unsigned int numNeighbours = GetNeighbourCells(cell, neighbours);
+		for (unsigned int entryA = cellStart_[cell]; entryA < cellStart_[cell + 1]; ++entryA)
+		{
+			unsigned int a = entries_[entryA];
+			for (unsigned int neighbour = 0; neighbour < numNeighbours; ++neighbour)
+			{
+				unsigned int neighbourCell = neighbours[neighbour];
+				for (unsigned int entryB = cellStart_[neighbourCell]; entryB < cellStart_[neighbourCell + 1]; ++entryB)
+				{
+					unsigned int b = entries_[entryB];
+					if (b > a && LayersCollide(input, a, b))
+					{
+						ColliderPair pair;
+						pair.a = a;
+						pair.b = b;
+						pairs->push_back(pair);
+					}
+				}
+			}
+		}
+	}
+}
+
+unsigned int GridBroadphase::GetNeighbourCells(unsigned int cell, unsigned int *neighbours) const
+{
+	int column = static_cast<int>(cell % columns_);
+	int row = static_cast<int>(cell / columns_);
+	int columns = static_cast<int>(columns_);
+	int rows = static_cast<int>(rows_);
+
+	// On grids under three cells across the wrapped neighbours repeat
+	unsigned int numNeighbours = 0;
+	for (int rowOffset = -1; rowOffset <= 1; ++rowOffset)
+	{
+		for (int columnOffset = -1; columnOffset <= 1; ++columnOffset)
+		{
+			unsigned int neighbourColumn = static_cast<unsigned int>((column + columnOffset + columns) % columns);
+			unsigned int neighbourRow = static_cast<unsigned int>((row + rowOffset + rows) % rows);
+			unsigned int neighbour = neighbourRow * columns_ + neighbourColumn;
+
+			if (std::find(neighbours, neighbours + numNeighbours, neighbour) == neighbours + numNeighbours)
+			{
+				neighbours[numNeighbours++] = neighbour;
+			}
+		}
+	}
+
+	return numNeighbours;
+}
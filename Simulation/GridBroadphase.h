@@ -0,0 +1,39 @@
+#ifndef GRIDBROADPHASE_H_INCLUDED
+#define GRIDBROADPHASE_H_INCLUDED
+
+#include <vector>
+#include "Broadphase.h"
+
+// Uniform grid broadphase, rebuilt from scratch every call. Cells are at
+// least as wide as the largest collider, so anything that can touch a
+// collider sits in its own cell or one of the eight around it; the grid wraps
+// like the world does, so neighbours across an edge are found too. Pairs come
+// out sorted, the same order a test of every pair would visit them in. The
+// search runs a few rows of cells at a time and the rows can go in parallel.
+class GridBroadphase : public Broadphase
+{
+public:
+	GridBroadphase();
+
+	void FindPairs(const BroadphaseInput &input,
+		JobSystem *jobs,
+		std::vector<ColliderPair> *pairs);
+
+	unsigned int GetNumCells() const;
+
+private:
+	void BuildGrid(const BroadphaseInput &input);
+	void FindPairsInRows(const BroadphaseInput &input, unsigned int beginRow, unsigned int endRow,
+		std::vector<ColliderPair> *pairs) const;
+	unsigned int GetNeighbourCells(unsigned int cell, unsigned int *neighbours) const;
+
+	unsigned int columns_;
+	unsigned int rows_;
+
+	std::vector<unsigned int> cellOf_;
+	std::vector<unsigned int> cellStart_;
+	std::vector<unsigned int> cellCursor_;
+	std::vector<unsigned int> entries_;
+};
+
+#endif // GRIDBROADPHASE_H_INCLUDED
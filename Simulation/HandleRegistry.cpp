@@ -0,0 +1,83 @@
+#include "HandleRegistry.h"
+
+HandleRegistry::HandleRegistry()
+{
+}
+
+EntityHandle HandleRegistry::Create(unsigned int denseIndex)
+{
+	uint32_t slotIndex;
+	if (freeSlots_.empty())
+	{
+		slotIndex = static_cast<uint32_t>(slots_.size());
+		Slot slot;
+		slot.generation = 0;
+		slots_.push_back(slot);
+	}
+	else
+	{
+		slotIndex = freeSlots_.back();
+		freeSlots_.pop_back();
+	}
+
+	Slot &slot = slots_[slotIndex];
+	slot.denseIndex = denseIndex;
+	slot.inUse = true;
+
+	return EntityHandle(slotIndex, slot.generation);
+}
+
+void HandleRegistry::Destroy(EntityHandle handle)
+{
+	unsigned int denseIndex;
+	if (!Resolve(handle, &denseIndex))
+		return;
+
+	Slot &slot = slots_[handle.index];
+	slot.inUse = false;
+	++slot.generation;
+	freeSlots_.push_back(handle.index);
+}
+
+void HandleRegistry::Move(EntityHandle handle, unsigned int denseIndex)
+{
+	unsigned int oldIndex;
+	if (Resolve(handle, &oldIndex))
+	{
+		slots_[handle.index].denseIndex = denseIndex;
+	}
+}
+
+bool HandleRegistry::Resolve(EntityHandle handle, unsigned int *denseIndex) const
+{
+	if (handle.index >= slots_.size())
+		return false;
+
+	const Slot &slot = slots_[handle.index];
+	if (!slot.inUse || slot.generation != handle.generation)
+		return false;
+
+	*denseIndex = slot.denseIndex;
+	return true;
+}
+
+void HandleRegistry::Clear()
+{
+	freeSlots_.clear();
+	for (uint32_t slotIndex = 0; slotIndex < slots_.size(); ++slotIndex)
+	{
+		Slot &slot = slots_[slotIndex];
+		if (slot.inUse)
+		{
+			slot.inUse = false;
+			++slot.generation;
+		}
+		freeSlots_.push_back(slotIndex);
+	}
+}
+
+void HandleRegistry::Reserve(unsigned int capacity)
+{
+	slots_.reserve(capacity);
+	freeSlots_.reserve(capacity);
+}
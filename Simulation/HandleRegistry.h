@@ -0,0 +1,35 @@
+#ifndef HANDLEREGISTRY_H_INCLUDED
+#define HANDLEREGISTRY_H_INCLUDED
+
+#include "EntityHandle.h"
+#include <vector>
+
+// Maps generational handles onto the current dense index of an entity in a
+// packed array. Creation, lookup, relocation and destruction are all O(1);
+// destroyed slots go on a free list and have their generation bumped.
+class HandleRegistry
+{
+public:
+	HandleRegistry();
+
+	EntityHandle Create(unsigned int denseIndex);
+	void Destroy(EntityHandle handle);
+	void Move(EntityHandle handle, unsigned int denseIndex);
+	bool Resolve(EntityHandle handle, unsigned int *denseIndex) const;
+	void Clear();
+	void Reserve(unsigned int capacity);
+
+private:
+
+	struct Slot
+	{
+		unsigned int denseIndex;
+		uint32_t generation;
+		bool inUse;
+	};
+
+	std::vector<Slot> slots_;
+	std::vector<uint32_t> freeSlots_;
+};
+
+#endif // HANDLEREGISTRY_H_INCLUDED
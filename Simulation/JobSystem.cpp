@@ -0,0 +1,215 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+	// Which pool, if any, the calling thread is a worker of
+	thread_local const JobSystem *currentSystem = nullptr;
+	thread_local unsigned int currentQueue = 0;
+}
+
+JobSystem *JobSystem::Create(unsigned int numWorkers)
+{
+	if (numWorkers == 0)
+	{
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		numWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	return new JobSystem(numWorkers);
+}
+
+void JobSystem::Destroy(JobSystem *jobs)
+{
+	delete jobs;
+}
+
+JobSystem::JobSystem(unsigned int numWorkers) :
+	queuedJobs_(0),
+	quit_(false)
+{
+	// Queue 0 belongs to the creating thread
+	for (unsigned int queueIndex = 0; queueIndex <= numWorkers; ++queueIndex)
+	{
+		queues_.push_back(new WorkQueue());
+	}
+
+	currentSystem = this;
+	currentQueue = 0;
+
+	for (unsigned int workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
+	{
+		workers_.push_back(std::thread(&JobSystem::WorkerMain, this, workerIndex + 1));
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		quit_ = true;
+	}
+	wake_.notify_all();
+
+	for (std::vector<std::thread>::iterator workerIt = workers_.begin(), end = workers_.end();
+		workerIt != end;
+		++workerIt)
+	{
+		workerIt->join();
+	}
+
+	for (std::vector<WorkQueue *>::iterator queueIt = queues_.begin(), end = queues_.end();
+		queueIt != end;
+		++queueIt)
+	{
+		delete *queueIt;
+	}
+
+	if (currentSystem == this)
+	{
+		currentSystem = nullptr;
+	}
+}
+
+void JobSystem::Run(const JobFunction &function, JobCounter *counter)
+{
+	if (counter)
+	{
+		counter->remaining.fetch_add(1);
+	}
+
+	Job job;
+	job.function = function;
+	job.counter = counter;
+
+	WorkQueue *queue = queues_[GetQueueIndex()];
+	{
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		queue->jobs.push_back(std::move(job));
+	}
+	queuedJobs_.fetch_add(1);
+
+	// Taking the lock orders this against a worker deciding to sleep
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+	}
+	wake_.notify_one();
+}
+
+void JobSystem::Wait(JobCounter *counter)
+{
+	unsigned int queueIndex = GetQueueIndex();
+	while (counter->remaining.load() > 0)
+	{
+		if (!RunOne(queueIndex))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::ParallelFor(unsigned int count, unsigned int grainSize, const RangeFunction &function)
+{
+	if (count == 0)
+		return;
+
+	if (grainSize == 0)
+		grainSize = 1;
+
+	unsigned int numChunks = (count + grainSize - 1) / grainSize;
+	if (numChunks == 1 || workers_.empty())
+	{
+		for (unsigned int begin = 0; begin < count; begin += grainSize)
+		{
+			function(begin, std::min(begin + grainSize, count));
+		}
+		return;
+	}
+
+	JobCounter counter;
+	for (unsigned int chunk = 1; chunk < numChunks; ++chunk)
+	{
+		unsigned int begin = chunk * grainSize;
+		unsigned int end = std::min(begin + grainSize, count);
+		Run([&function, begin, end]() { function(begin, end); }, &counter);
+	}
+
+	// Do the first chunk here rather than sit idle
+	function(0, grainSize);
+	Wait(&counter);
+}
+
+unsigned int JobSystem::GetNumThreads() const
+{
+	return static_cast<unsigned int>(queues_.size());
+}
+
+void JobSystem::WorkerMain(unsigned int queueIndex)
+{
+	currentSystem = this;
+	currentQueue = queueIndex;
+
+	for (;;)
+	{
+		if (RunOne(queueIndex))
+			continue;
+
+		std::unique_lock<std::mutex> lock(sleepMutex_);
+		wake_.wait(lock, [this]() { return quit_ || queuedJobs_.load() > 0; });
+		if (quit_)
+			return;
+	}
+}
+
+unsigned int JobSystem::GetQueueIndex() const
+{
+	return currentSystem == this ? currentQueue : 0;
+}
+
+bool JobSystem::PopOrSteal(unsigned int queueIndex, Job *job)
+{
+	// Own queue first, newest job, while it is still warm in cache
+	{
+		WorkQueue *queue = queues_[queueIndex];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		if (!queue->jobs.empty())
+		{
+			*job = std::move(queue->jobs.back());
+			queue->jobs.pop_back();
+			return true;
+		}
+	}
+
+	// Then steal the oldest job from everyone else in turn
+	unsigned int numQueues = static_cast<unsigned int>(queues_.size());
+	for (unsigned int offset = 1; offset < numQueues; ++offset)
+	{
+		WorkQueue *queue = queues_[(queueIndex + offset) % numQueues];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		if (!queue->jobs.empty())
+		{
+			*job = std::move(queue->jobs.front());
+			queue->jobs.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool JobSystem::RunOne(unsigned int queueIndex)
+{
+	Job job;
+	if (!PopOrSteal(queueIndex, &job))
+		return false;
+
+	queuedJobs_.fetch_sub(1);
+	job.function();
+
+	if (job.counter)
+	{
+		job.counter->remaining.fetch_sub(1);
+	}
+	return true;
+}
@@ -0,0 +1,79 @@
+#ifndef JOBSYSTEM_H_INCLUDED
+#define JOBSYSTEM_H_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Counts outstanding jobs; Wait() returns once it reaches zero.
+struct JobCounter
+{
+	JobCounter() :
+		remaining(0)
+	{
+	}
+
+	std::atomic<unsigned int> remaining;
+};
+
+// Work-stealing thread pool. Every thread, including the one that created
+// the system, owns a queue; a thread pops its own newest job and otherwise
+// steals the oldest job from another queue. Waiting threads keep running
+// jobs instead of blocking, so jobs may themselves submit and wait on work.
+class JobSystem
+{
+public:
+	typedef std::function<void()> JobFunction;
+	typedef std::function<void(unsigned int begin, unsigned int end)> RangeFunction;
+
+	// numWorkers extra threads; 0 picks one fewer than the hardware threads
+	static JobSystem *Create(unsigned int numWorkers);
+	static void Destroy(JobSystem *jobs);
+
+	void Run(const JobFunction &function, JobCounter *counter);
+	void Wait(JobCounter *counter);
+
+	// Splits [0, count) into chunks of grainSize and runs them across the
+	// pool. Chunk boundaries depend only on count and grainSize, never on the
+	// number of threads, so per-chunk results can be merged deterministically.
+	void ParallelFor(unsigned int count, unsigned int grainSize, const RangeFunction &function);
+
+	unsigned int GetNumThreads() const;
+
+private:
+	struct Job
+	{
+		JobFunction function;
+		JobCounter *counter;
+	};
+
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	explicit JobSystem(unsigned int numWorkers);
+	~JobSystem();
+	JobSystem(const JobSystem &);
+	void operator=(const JobSystem &);
+
+	void WorkerMain(unsigned int queueIndex);
+	unsigned int GetQueueIndex() const;
+	bool PopOrSteal(unsigned int queueIndex, Job *job);
+	bool RunOne(unsigned int queueIndex);
+
+	std::vector<WorkQueue *> queues_;
+	std::vector<std::thread> workers_;
+
+	std::mutex sleepMutex_;
+	std::condition_variable wake_;
+	std::atomic<unsigned int> queuedJobs_;
+	bool quit_;
+};
+
+#endif // JOBSYSTEM_H_INCLUDED
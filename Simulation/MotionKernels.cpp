@@ -0,0 +1,145 @@
+#include "MotionKernels.h"
+#include "SimdSupport.h"
+#include <atomic>
+
+namespace
+{
+	// The first kernels to run may be on several workers at once, so the
+	// choice is made with a compare-exchange rather than a plain write
+	const int PATH_UNSELECTED = -1;
+	std::atomic<int> selectedPath(PATH_UNSELECTED);
+
+#if defined(SIMD_X86)
+	bool CpuSupportsAVX2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		// OSXSAVE and AVX, then check the OS saves the YMM registers
+		__cpuid(info, 1);
+		if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+			return false;
+		if ((_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+#endif
+}
+
+void MotionKernels::IntegrateWrap(float *values,
+	const float *rates,
+	float scale,
+	unsigned int count,
+	float min,
+	float max)
+{
+	switch (GetPath())
+	{
+	case PATH_AVX2: IntegrateWrapAVX2(values, rates, scale, count, min, max); break;
+	case PATH_SSE2: IntegrateWrapSSE2(values, rates, scale, count, min, max); break;
+	default: IntegrateWrapScalar(values, rates, scale, count, min, max); break;
+	}
+}
+
+MotionKernels::Path MotionKernels::GetPath()
+{
+	int path = selectedPath.load(std::memory_order_acquire);
+	if (path == PATH_UNSELECTED)
+	{
+		int bestPath = GetBestSupportedPath();
+		if (selectedPath.compare_exchange_strong(path, bestPath, std::memory_order_acq_rel, std::memory_order_acquire))
+			path = bestPath;
+	}
+	return static_cast<Path>(path);
+}
+
+void MotionKernels::SetPath(Path path)
+{
+	if (path > GetBestSupportedPath())
+		path = GetBestSupportedPath();
+
+	selectedPath.store(path, std::memory_order_release);
+}
+
+MotionKernels::Path MotionKernels::GetBestSupportedPath()
+{
+#if defined(SIMD_X86)
+	static const bool hasAVX2 = CpuSupportsAVX2();
+	return hasAVX2 ? PATH_AVX2 : PATH_SSE2;
+#else
+	return PATH_SCALAR;
+#endif
+}
+
+void MotionKernels::IntegrateWrapScalar(float *values, const float *rates, float scale, unsigned int count, float min, float max)
+{
+	for (unsigned int index = 0; index < count; ++index)
+	{
+		values[index] = WrapValue(values[index] + rates[index] * scale, min, max);
+	}
+}
+
+#if defined(SIMD_X86)
+
+void MotionKernels::IntegrateWrapSSE2(float *values, const float *rates, float scale, unsigned int count, float min, float max)
+{
+	const float range = max - min;
+	const __m128 minimum = _mm_set1_ps(min);
+	const __m128 width = _mm_set1_ps(range);
+	const __m128 inverseWidth = _mm_set1_ps(1.0f / range);
+	const __m128 step = _mm_set1_ps(scale);
+
+	unsigned int index = 0;
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 value = _mm_add_ps(_mm_loadu_ps(values + index), _mm_mul_ps(_mm_loadu_ps(rates + index), step));
+		__m128 wraps = FloorSSE2(_mm_mul_ps(_mm_sub_ps(value, minimum), inverseWidth));
+		_mm_storeu_ps(values + index, _mm_sub_ps(value, _mm_mul_ps(wraps, width)));
+	}
+
+	IntegrateWrapScalar(values + index, rates + index, scale, count - index, min, max);
+}
+
+// Multiply then add, never fused, to round the same as the scalar path
+SIMD_AVX2_TARGET
+void MotionKernels::IntegrateWrapAVX2(float *values, const float *rates, float scale, unsigned int count, float min, float max)
+{
+	const float range = max - min;
+	const __m256 minimum = _mm256_set1_ps(min);
+	const __m256 width = _mm256_set1_ps(range);
+	const __m256 inverseWidth = _mm256_set1_ps(1.0f / range);
+	const __m256 step = _mm256_set1_ps(scale);
+
+	unsigned int index = 0;
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 value = _mm256_add_ps(_mm256_loadu_ps(values + index), _mm256_mul_ps(_mm256_loadu_ps(rates + index), step));
+		__m256 wraps = _mm256_floor_ps(_mm256_mul_ps(_mm256_sub_ps(value, minimum), inverseWidth));
+		_mm256_storeu_ps(values + index, _mm256_sub_ps(value, _mm256_mul_ps(wraps, width)));
+	}
+	_mm256_zeroupper();
+
+	IntegrateWrapSSE2(values + index, rates + index, scale, count - index, min, max);
+}
+
+#else
+
+void MotionKernels::IntegrateWrapSSE2(float *values, const float *rates, float scale, unsigned int count, float min, float max)
+{
+	IntegrateWrapScalar(values, rates, scale, count, min, max);
+}
+
+void MotionKernels::IntegrateWrapAVX2(float *values, const float *rates, float scale, unsigned int count, float min, float max)
+{
+	IntegrateWrapScalar(values, rates, scale, count, min, max);
+}
+
+#endif
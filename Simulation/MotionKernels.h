@@ -0,0 +1,53 @@
+#ifndef MOTIONKERNELS_H_INCLUDED
+#define MOTIONKERNELS_H_INCLUDED
+
+#include <cmath>
+
+// Batch kernels for moving packed arrays of values. IntegrateWrap adds a rate
+// times a common scale to every value and wraps the result into [min, max)
+// with a floor instead of a loop, so there are no branches per element. The
+// SIMD paths perform the same operations in the same order as the scalar one
+// and give identical results; the widest path the CPU supports is picked on
+// first use.
+class MotionKernels
+{
+public:
+	enum Path
+	{
+		PATH_SCALAR,
+		PATH_SSE2,
+		PATH_AVX2
+	};
+
+	static void IntegrateWrap(float *values,
+		const float *rates,
+		float scale,
+		unsigned int count,
+		float min,
+		float max);
+
+	static Path GetPath();
+	static void SetPath(Path path);
+	static Path GetBestSupportedPath();
+
+	static float WrapValue(float value, float min, float max)
+	{
+		float range = max - min;
+		float wraps = std::floor((value - min) * (1.0f / range));
+		return value - wraps * range;
+	}
+
+	// Shortest signed separation along one axis of the wrapping world, the
+	// scalar form of what the narrowphase kernels do a lane at a time
+	static float WrapDelta(float delta, float size, float inverseSize)
+	{
+		return delta - size * std::floor(delta * inverseSize + 0.5f);
+	}
+
+private:
+	static void IntegrateWrapScalar(float *values, const float *rates, float scale, unsigned int count, float min, float max);
+	static void IntegrateWrapSSE2(float *values, const float *rates, float scale, unsigned int count, float min, float max);
+	static void IntegrateWrapAVX2(float *values, const float *rates, float scale, unsigned int count, float min, float max);
+};
+
+#endif // MOTIONKERNELS_H_INCLUDED
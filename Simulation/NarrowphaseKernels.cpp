@@ -0,0 +1,208 @@
+#include "NarrowphaseKernels.h"
+#include "MotionKernels.h"
+#include "SimdSupport.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	bool TestPair(const NarrowphaseInput &input, unsigned int a, unsigned int b,
+		float width, float inverseWidth, float height, float inverseHeight)
+	{
+		// Work relative to b, so b stands still and a moves along a segment
+		float dx = MotionKernels::WrapDelta(input.startX[a] - input.startX[b], width, inverseWidth);
+		float dy = MotionKernels::WrapDelta(input.startY[a] - input.startY[b], height, inverseHeight);
+		float moveX = input.moveX[a] - input.moveX[b];
+		float moveY = input.moveY[a] - input.moveY[b];
+		float radii = input.radius[a] + input.radius[b];
+
+		// Closest approach along the segment
+		float moveLengthSq = moveX * moveX + moveY * moveY;
+		if (moveLengthSq > 0.0f)
+		{
+			float t = -(dx * moveX + dy * moveY) / moveLengthSq;
+			t = std::max(0.0f, std::min(t, 1.0f));
+			dx += moveX * t;
+			dy += moveY * t;
+		}
+
+		return (dx * dx + dy * dy) < (radii * radii);
+	}
+}
+
+unsigned int NarrowphaseKernels::TestPairs(const NarrowphaseInput &input,
+	const ColliderPair *pairs,
+	unsigned int count,
+	ColliderPair *contacts)
+{
+	switch (MotionKernels::GetPath())
+	{
+	case MotionKernels::PATH_AVX2: return TestPairsAVX2(input, pairs, count, contacts);
+	case MotionKernels::PATH_SSE2: return TestPairsSSE2(input, pairs, count, contacts);
+	default: return TestPairsScalar(input, pairs, count, contacts);
+	}
+}
+
+unsigned int NarrowphaseKernels::TestPairsScalar(const NarrowphaseInput &input, const ColliderPair *pairs, unsigned int count, ColliderPair *contacts)
+{
+	float width = input.bounds.GetWidth();
+	float height = input.bounds.GetHeight();
+	float inverseWidth = 1.0f / width;
+	float inverseHeight = 1.0f / height;
+
+	unsigned int numContacts = 0;
+	for (unsigned int index = 0; index < count; ++index)
+	{
+		if (TestPair(input, pairs[index].a, pairs[index].b, width, inverseWidth, height, inverseHeight))
+		{
+			contacts[numContacts++] = pairs[index];
+		}
+	}
+	return numContacts;
+}
+
+#if defined(SIMD_X86)
+
+namespace
+{
+	__m128 WrapDeltaSSE2(__m128 delta, __m128 size, __m128 inverseSize)
+	{
+		__m128 wraps = FloorSSE2(_mm_add_ps(_mm_mul_ps(delta, inverseSize), _mm_set1_ps(0.5f)));
+		return _mm_sub_ps(delta, _mm_mul_ps(size, wraps));
+	}
+
+	__m128 GatherSSE2(const float *values, const unsigned int *indices)
+	{
+		return _mm_set_ps(values[indices[3]], values[indices[2]], values[indices[1]], values[indices[0]]);
+	}
+
+	SIMD_AVX2_TARGET
+	__m256 WrapDeltaAVX2(__m256 delta, __m256 size, __m256 inverseSize)
+	{
+		__m256 wraps = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(delta, inverseSize), _mm256_set1_ps(0.5f)));
+		return _mm256_sub_ps(delta, _mm256_mul_ps(size, wraps));
+	}
+}
+
+unsigned int NarrowphaseKernels::TestPairsSSE2(const NarrowphaseInput &input, const ColliderPair *pairs, unsigned int count, ColliderPair *contacts)
+{
+	const float widthScalar = input.bounds.GetWidth();
+	const float heightScalar = input.bounds.GetHeight();
+	const __m128 width = _mm_set1_ps(widthScalar);
+	const __m128 height = _mm_set1_ps(heightScalar);
+	const __m128 inverseWidth = _mm_set1_ps(1.0f / widthScalar);
+	const __m128 inverseHeight = _mm_set1_ps(1.0f / heightScalar);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+
+	unsigned int numContacts = 0;
+	unsigned int index = 0;
+	for (; index + 4 <= count; index += 4)
+	{
+		unsigned int a[4];
+		unsigned int b[4];
+		for (unsigned int lane = 0; lane < 4; ++lane)
+		{
+			a[lane] = pairs[index + lane].a;
+			b[lane] = pairs[index + lane].b;
+		}
+
+		__m128 dx = WrapDeltaSSE2(_mm_sub_ps(GatherSSE2(input.startX, a), GatherSSE2(input.startX, b)), width, inverseWidth);
+		__m128 dy = WrapDeltaSSE2(_mm_sub_ps(GatherSSE2(input.startY, a), GatherSSE2(input.startY, b)), height, inverseHeight);
+		__m128 moveX = _mm_sub_ps(GatherSSE2(input.moveX, a), GatherSSE2(input.moveX, b));
+		__m128 moveY = _mm_sub_ps(GatherSSE2(input.moveY, a), GatherSSE2(input.moveY, b));
+		__m128 radii = _mm_add_ps(GatherSSE2(input.radius, a), GatherSSE2(input.radius, b));
+
+		// Lanes that did not move keep their start separation
+		__m128 moveLengthSq = _mm_add_ps(_mm_mul_ps(moveX, moveX), _mm_mul_ps(moveY, moveY));
+		__m128 moved = _mm_cmpgt_ps(moveLengthSq, zero);
+		__m128 along = _mm_xor_ps(_mm_add_ps(_mm_mul_ps(dx, moveX), _mm_mul_ps(dy, moveY)), signBit);
+		__m128 t = _mm_max_ps(_mm_min_ps(_mm_div_ps(along, moveLengthSq), one), zero);
+		t = _mm_and_ps(moved, t);
+		dx = _mm_add_ps(dx, _mm_mul_ps(moveX, t));
+		dy = _mm_add_ps(dy, _mm_mul_ps(moveY, t));
+
+		__m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		int hits = _mm_movemask_ps(_mm_cmplt_ps(distanceSq, _mm_mul_ps(radii, radii)));
+		for (unsigned int lane = 0; hits != 0; ++lane, hits >>= 1)
+		{
+			if (hits & 1)
+			{
+				contacts[numContacts++] = pairs[index + lane];
+			}
+		}
+	}
+
+	return numContacts + TestPairsScalar(input, pairs + index, count - index, contacts + numContacts);
+}
+
+SIMD_AVX2_TARGET
+unsigned int NarrowphaseKernels::TestPairsAVX2(const NarrowphaseInput &input, const ColliderPair *pairs, unsigned int count, ColliderPair *contacts)
+{
+	const float widthScalar = input.bounds.GetWidth();
+	const float heightScalar = input.bounds.GetHeight();
+	const __m256 width = _mm256_set1_ps(widthScalar);
+	const __m256 height = _mm256_set1_ps(heightScalar);
+	const __m256 inverseWidth = _mm256_set1_ps(1.0f / widthScalar);
+	const __m256 inverseHeight = _mm256_set1_ps(1.0f / heightScalar);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+	unsigned int numContacts = 0;
+	unsigned int index = 0;
+	for (; index + 8 <= count; index += 8)
+	{
+		int a[8];
+		int b[8];
+		for (unsigned int lane = 0; lane < 8; ++lane)
+		{
+			a[lane] = static_cast<int>(pairs[index + lane].a);
+			b[lane] = static_cast<int>(pairs[index + lane].b);
+		}
+		__m256i indexA = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a));
+		__m256i indexB = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b));
+
+		__m256 dx = WrapDeltaAVX2(_mm256_sub_ps(_mm256_i32gather_ps(input.startX, indexA, 4), _mm256_i32gather_ps(input.startX, indexB, 4)), width, inverseWidth);
+		__m256 dy = WrapDeltaAVX2(_mm256_sub_ps(_mm256_i32gather_ps(input.startY, indexA, 4), _mm256_i32gather_ps(input.startY, indexB, 4)), height, inverseHeight);
+		__m256 moveX = _mm256_sub_ps(_mm256_i32gather_ps(input.moveX, indexA, 4), _mm256_i32gather_ps(input.moveX, indexB, 4));
+		__m256 moveY = _mm256_sub_ps(_mm256_i32gather_ps(input.moveY, indexA, 4), _mm256_i32gather_ps(input.moveY, indexB, 4));
+		__m256 radii = _mm256_add_ps(_mm256_i32gather_ps(input.radius, indexA, 4), _mm256_i32gather_ps(input.radius, indexB, 4));
+
+		__m256 moveLengthSq = _mm256_add_ps(_mm256_mul_ps(moveX, moveX), _mm256_mul_ps(moveY, moveY));
+		__m256 moved = _mm256_cmp_ps(moveLengthSq, zero, _CMP_GT_OQ);
+		__m256 along = _mm256_xor_ps(_mm256_add_ps(_mm256_mul_ps(dx, moveX), _mm256_mul_ps(dy, moveY)), signBit);
+		__m256 t = _mm256_max_ps(_mm256_min_ps(_mm256_div_ps(along, moveLengthSq), one), zero);
+		t = _mm256_and_ps(moved, t);
+		dx = _mm256_add_ps(dx, _mm256_mul_ps(moveX, t));
+		dy = _mm256_add_ps(dy, _mm256_mul_ps(moveY, t));
+
+		__m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		int hits = _mm256_movemask_ps(_mm256_cmp_ps(distanceSq, _mm256_mul_ps(radii, radii), _CMP_LT_OQ));
+		for (unsigned int lane = 0; hits != 0; ++lane, hits >>= 1)
+		{
+			if (hits & 1)
+			{
+				contacts[numContacts++] = pairs[index + lane];
+			}
+		}
+	}
+	_mm256_zeroupper();
+
+	return numContacts + TestPairsSSE2(input, pairs + index, count - index, contacts + numContacts);
+}
+
+#else
+
+unsigned int NarrowphaseKernels::TestPairsSSE2(const NarrowphaseInput &input, const ColliderPair *pairs, unsigned int count, ColliderPair *contacts)
+{
+	return TestPairsScalar(input, pairs, count, contacts);
+}
+
+unsigned int NarrowphaseKernels::TestPairsAVX2(const NarrowphaseInput &input, const ColliderPair *pairs, unsigned int count, ColliderPair *contacts)
+{
+	return TestPairsScalar(input, pairs, count, contacts);
+}
+
+#endif
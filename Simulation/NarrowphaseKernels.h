@@ -0,0 +1,39 @@
+#ifndef NARROWPHASEKERNELS_H_INCLUDED
+#define NARROWPHASEKERNELS_H_INCLUDED
+
+#include "Broadphase.h"
+#include "WorldBounds.h"
+
+// Packed colliders for the narrowphase. Each moved from start by move during
+// the pass; colliders that are not swept have no move.
+struct NarrowphaseInput
+{
+	const float *startX;
+	const float *startY;
+	const float *moveX;
+	const float *moveY;
+	const float *radius;
+	WorldBounds bounds;
+};
+
+// Exact tests of broadphase candidates. TestPairs checks every pair on the
+// wrapped world, sweeping one circle along the pair's relative motion, and
+// writes the pairs that touch to contacts, which needs room for count pairs,
+// keeping their order. The SSE2 and AVX2 paths test four and eight pairs at a
+// time with the same operations as the scalar path and give the same contacts.
+// The path follows MotionKernels::GetPath().
+class NarrowphaseKernels
+{
+public:
+	static unsigned int TestPairs(const NarrowphaseInput &input,
+		const ColliderPair *pairs,
+		unsigned int count,
+		ColliderPair *contacts);
+
+private:
+	static unsigned int TestPairsScalar(const NarrowphaseInput &input, const ColliderPair *pairs, unsigned int count, ColliderPair *contacts);
+	static unsigned int TestPairsSSE2(const NarrowphaseInput &input, const ColliderPair *pairs, unsigned int count, ColliderPair *contacts);
+	static unsigned int TestPairsAVX2(const NarrowphaseInput &input, const ColliderPair *pairs, unsigned int count, ColliderPair *contacts);
+};
+
+#endif // NARROWPHASEKERNELS_H_INCLUDED
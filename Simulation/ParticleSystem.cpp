@@ -0,0 +1,162 @@
+#include "ParticleSystem.h"
+#include "Random.h"
+
+namespace
+{
+	// The analytic clock in closed form. After age t, with ticks of dt, the
+	// active time is t(t + dt) / 2dt, and the total of the active times over
+	// every tick so far, which is how far particles have gone per unit of
+	// velocity, is t(t + dt)(t + 2dt) / 6dt^2. On tick boundaries both match
+	// adding up tick by tick exactly.
+	float GetActiveTime(float age, float tickSeconds)
+	{
+		return age * (age + tickSeconds) / (2.0f * tickSeconds);
+	}
+
+	float GetTravel(float age, float tickSeconds)
+	{
+		return age * (age + tickSeconds) * (age + 2.0f * tickSeconds) / (6.0f * tickSeconds * tickSeconds);
+	}
+}
+
+void ParticleSystem::Reserve(unsigned int maxEmitters)
+{
+	emitters_.reserve(maxEmitters);
+	freeEmitters_.reserve(maxEmitters);
+}
+
+void ParticleSystem::Clear()
+{
+	emitters_.clear();
+	freeEmitters_.clear();
+}
+
+unsigned int ParticleSystem::CreateAnalyticEmitter(float x, float y, uint32_t seed, double startTime,
+	const AnalyticEmitterDesc *desc)
+{
+	unsigned int emitter;
+	if (!freeEmitters_.empty())
+	{
+		emitter = freeEmitters_.back();
+		freeEmitters_.pop_back();
+	}
+	else
+	{
+		emitter = static_cast<unsigned int>(emitters_.size());
+		emitters_.push_back(Emitter());
+	}
+
+	Emitter &state = emitters_[emitter];
+	state.x = x;
+	state.y = y;
+	state.inUse = true;
+	state.desc = desc;
+	state.seed = seed;
+	state.startTime = startTime;
+	return emitter;
+}
+
+void ParticleSystem::DestroyEmitter(unsigned int emitter)
+{
+	Emitter &state = emitters_[emitter];
+	if (!state.inUse)
+		return;
+
+	state.inUse = false;
+	freeEmitters_.push_back(emitter);
+}
+
+float ParticleSystem::GetEmitterX(unsigned int emitter) const
+{
+	return emitters_[emitter].x;
+}
+
+float ParticleSystem::GetEmitterY(unsigned int emitter) const
+{
+	return emitters_[emitter].y;
+}
+
+bool ParticleSystem::IsEmitterFinished(unsigned int emitter, double time) const
+{
+	const Emitter &state = emitters_[emitter];
+	return time - state.startTime >= state.desc->duration;
+}
+
+unsigned int ParticleSystem::GetMaxAnalyticParticles() const
+{
+	unsigned int numParticles = 0;
+	for (std::vector<Emitter>::const_iterator emitterIt = emitters_.begin(), end = emitters_.end();
+		emitterIt != end;
+		++emitterIt)
+	{
+		if (!emitterIt->inUse)
+			continue;
+
+		const AnalyticEmitterDesc &desc = *emitterIt->desc;
+		for (unsigned int wave = 0; wave < desc.numWaves; ++wave)
+		{
+			numParticles += desc.waves[wave].count;
+		}
+	}
+	return numParticles;
+}
+
+unsigned int ParticleSystem::EvaluateAnalytic(double time, float *positionsX, float *positionsY,
+	unsigned int maxParticles) const
+{
+	unsigned int numWritten = 0;
+	for (std::vector<Emitter>::const_iterator emitterIt = emitters_.begin(), end = emitters_.end();
+		emitterIt != end;
+		++emitterIt)
+	{
+		if (!emitterIt->inUse)
+			continue;
+
+		const AnalyticEmitterDesc &desc = *emitterIt->desc;
+		float age = static_cast<float>(time - emitterIt->startTime);
+		float activeTime = GetActiveTime(age, desc.tickSeconds);
+		float travel = GetTravel(age, desc.tickSeconds);
+
+		const PatternBank &patterns = *desc.patterns;
+		unsigned int pattern = emitterIt->seed % patterns.GetNumPatterns();
+		const float *burstX = patterns.GetBurstVelocitiesX(pattern);
+		const float *burstY = patterns.GetBurstVelocitiesY(pattern);
+		const float *burstLifeTimes = patterns.GetBurstLifeTimes(pattern);
+
+		for (unsigned int waveIndex = 0; waveIndex < desc.numWaves; ++waveIndex)
+		{
+			const ParticleWave &wave = desc.waves[waveIndex];
+			if (wave.startAge > age)
+				break;
+
+			float waveAge = activeTime - GetActiveTime(wave.startAge, desc.tickSeconds);
+			float waveTravel = travel - GetTravel(wave.startAge, desc.tickSeconds);
+
+			// Flipping and swapping axes keeps the pattern's square spread
+			uint32_t choice = Random::Hash(emitterIt->seed + waveIndex);
+			unsigned int entry = choice % PatternBank::BURST_PARTICLES;
+			float turnX = (choice & 0x80000000U) ? -wave.speed : wave.speed;
+			float turnY = (choice & 0x40000000U) ? -wave.speed : wave.speed;
+			bool swapAxes = (choice & 0x20000000U) != 0;
+
+			for (unsigned int index = 0; index < wave.count; ++index)
+			{
+				float lifeTime = wave.lifeTime + wave.lifeTimeRange * burstLifeTimes[entry];
+				if (waveAge <= lifeTime)
+				{
+					if (numWritten == maxParticles)
+						return numWritten;
+
+					float velocityX = turnX * (swapAxes ? burstY[entry] : burstX[entry]);
+					float velocityY = turnY * (swapAxes ? burstX[entry] : burstY[entry]);
+					positionsX[numWritten] = emitterIt->x + velocityX * waveTravel;
+					positionsY[numWritten] = emitterIt->y + velocityY * waveTravel;
+					++numWritten;
+				}
+
+				entry = entry + 1 < PatternBank::BURST_PARTICLES ? entry + 1 : 0;
+			}
+		}
+	}
+	return numWritten;
+}
@@ -0,0 +1,79 @@
+#ifndef PARTICLESYSTEM_H_INCLUDED
+#define PARTICLESYSTEM_H_INCLUDED
+
+#include <vector>
+#include <stdint.h>
+#include "PatternBank.h"
+
+// A burst of particles leaving an analytic emitter's origin together, each
+// with a random velocity of up to speed along each axis and living for
+// lifeTime plus up to lifeTimeRange.
+struct ParticleWave
+{
+	float startAge;
+	unsigned int count;
+	float speed;
+	float lifeTime;
+	float lifeTimeRange;
+};
+
+// Everything an analytic emitter does, shared by all emitters of one kind.
+// Its clock speeds up the way explosions always have: every tick its active
+// time grows by its age, and its particles age by that active time and move
+// their velocity times it. The emitter is finished once its age reaches
+// duration. Ages are in seconds since the emitter was created. Particle
+// velocities and lifetimes come from burst patterns in the bank.
+struct AnalyticEmitterDesc
+{
+	const PatternBank *patterns;
+	const ParticleWave *waves;
+	unsigned int numWaves;
+	float tickSeconds;
+	float duration;
+};
+
+// Every particle in the game, none of them stored. Each belongs to an
+// analytic emitter, which an effect such as an explosion owns. Its particles'
+// paths follow from its seed, its creation time and its description in
+// closed form, so EvaluateAnalytic() can work out where they all are at any
+// moment and nothing is updated in between. The seed picks a burst pattern,
+// and each wave reads a run of it from its own start, with its axes flipped
+// or swapped to vary it further.
+class ParticleSystem
+{
+public:
+	// Emitter slots are reserved up front and reused once destroyed
+	void Reserve(unsigned int maxEmitters);
+	void Clear();
+
+	// desc must outlive the emitter
+	unsigned int CreateAnalyticEmitter(float x, float y, uint32_t seed, double startTime,
+		const AnalyticEmitterDesc *desc);
+	void DestroyEmitter(unsigned int emitter);
+	float GetEmitterX(unsigned int emitter) const;
+	float GetEmitterY(unsigned int emitter) const;
+	bool IsEmitterFinished(unsigned int emitter, double time) const;
+
+	// The most particles the analytic emitters can have alive at once
+	unsigned int GetMaxAnalyticParticles() const;
+	// Where every live particle of every analytic emitter is at time, in
+	// world coordinates; writes up to maxParticles and returns how many
+	unsigned int EvaluateAnalytic(double time, float *positionsX, float *positionsY,
+		unsigned int maxParticles) const;
+
+private:
+	struct Emitter
+	{
+		float x;
+		float y;
+		bool inUse;
+		const AnalyticEmitterDesc *desc;
+		uint32_t seed;
+		double startTime;
+	};
+
+	std::vector<Emitter> emitters_;
+	std::vector<unsigned int> freeEmitters_;
+};
+
+#endif // PARTICLESYSTEM_H_INCLUDED
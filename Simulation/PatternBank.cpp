@@ -0,0 +1,75 @@
+#include "PatternBank.h"
+#include "Random.h"
+
+PatternBank::PatternBank(unsigned int numPatterns, uint32_t seed) :
+	numPatterns_(0)
+{
+	Build(numPatterns, seed);
+}
+
+void PatternBank::Build(unsigned int numPatterns, uint32_t seed)
+{
+	numPatterns_ = numPatterns > 0 ? numPatterns : 1;
+	exhaustPoints_.resize(numPatterns_ * EXHAUST_POINTS);
+	burstVelocitiesX_.resize(numPatterns_ * BURST_PARTICLES);
+	burstVelocitiesY_.resize(numPatterns_ * BURST_PARTICLES);
+	burstLifeTimes_.resize(numPatterns_ * BURST_PARTICLES);
+
+	Random random(seed);
+
+	//Points in the exhaust triangle below the ship, A(0, -5), B(-10, -30), C(10, -30)
+	XMFLOAT2 v1(-10 - 0, -30 - (-5));	//Vector from top vertex to bottom left(B - A)
+	XMFLOAT2 v2(10 - 0, -30 - (-5));	//(C - A)
+	for (std::vector<XMFLOAT2>::iterator pointIt = exhaustPoints_.begin(), end = exhaustPoints_.end();
+		pointIt != end;
+		++pointIt)
+	{
+		//Generate points in quad
+		pointIt->x = random.NextFloat() * v1.x;
+		pointIt->x += random.NextFloat() * v2.x;
+		pointIt->y = random.NextFloat() * v1.y;
+		pointIt->y += random.NextFloat() * v2.y;
+
+		//If points below y=-30, bring into exhaust triangle
+		if (pointIt->y < -30.f)
+		{
+			pointIt->y += 25.f;
+		}
+	}
+
+	unsigned int numBurstParticles = numPatterns_ * BURST_PARTICLES;
+	random.Fill(burstVelocitiesX_.data(), numBurstParticles, -1.f, 1.f);
+	random.Fill(burstVelocitiesY_.data(), numBurstParticles, -1.f, 1.f);
+	random.Fill(burstLifeTimes_.data(), numBurstParticles, 0.f, 1.f);
+}
+
+unsigned int PatternBank::GetNumPatterns() const
+{
+	return numPatterns_;
+}
+
+unsigned int PatternBank::GetMemoryUsed() const
+{
+	return static_cast<unsigned int>(exhaustPoints_.size() * sizeof(XMFLOAT2) +
+		(burstVelocitiesX_.size() + burstVelocitiesY_.size() + burstLifeTimes_.size()) * sizeof(float));
+}
+
+const XMFLOAT2 *PatternBank::GetExhaustPoints(unsigned int pattern) const
+{
+	return &exhaustPoints_[(pattern % numPatterns_) * EXHAUST_POINTS];
+}
+
+const float *PatternBank::GetBurstVelocitiesX(unsigned int pattern) const
+{
+	return &burstVelocitiesX_[(pattern % numPatterns_) * BURST_PARTICLES];
+}
+
+const float *PatternBank::GetBurstVelocitiesY(unsigned int pattern) const
+{
+	return &burstVelocitiesY_[(pattern % numPatterns_) * BURST_PARTICLES];
+}
+
+const float *PatternBank::GetBurstLifeTimes(unsigned int pattern) const
+{
+	return &burstLifeTimes_[(pattern % numPatterns_) * BURST_PARTICLES];
+}
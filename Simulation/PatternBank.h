@@ -0,0 +1,47 @@
+#ifndef PATTERNBANK_H_INCLUDED
+#define PATTERNBANK_H_INCLUDED
+
+#include <DirectXMath.h>
+#include <vector>
+#include <stdint.h>
+
+using namespace DirectX;
+
+// Random-looking effect data worked out once at startup, so drawing an
+// effect is a table lookup rather than a run of random draws. There are
+// numPatterns of each kind of table; more patterns cost memory and give
+// more variety. Everything follows from the seed, so two banks built alike
+// hold the same patterns.
+//
+// An exhaust pattern is a set of points in a ship's exhaust, in ship space.
+// A burst pattern is a table of particle velocities, each axis in [-1, 1],
+// and lifetime fractions in [0, 1).
+class PatternBank
+{
+public:
+	static const unsigned int DEFAULT_NUM_PATTERNS = 32;
+	static const unsigned int EXHAUST_POINTS = 25;
+	static const unsigned int BURST_PARTICLES = 128;
+
+	explicit PatternBank(unsigned int numPatterns = DEFAULT_NUM_PATTERNS, uint32_t seed = 0);
+
+	void Build(unsigned int numPatterns, uint32_t seed);
+
+	unsigned int GetNumPatterns() const;
+	unsigned int GetMemoryUsed() const;
+
+	// Patterns past the end wrap around
+	const XMFLOAT2 *GetExhaustPoints(unsigned int pattern) const;
+	const float *GetBurstVelocitiesX(unsigned int pattern) const;
+	const float *GetBurstVelocitiesY(unsigned int pattern) const;
+	const float *GetBurstLifeTimes(unsigned int pattern) const;
+
+private:
+	unsigned int numPatterns_;
+	std::vector<XMFLOAT2> exhaustPoints_;
+	std::vector<float> burstVelocitiesX_;
+	std::vector<float> burstVelocitiesY_;
+	std::vector<float> burstLifeTimes_;
+};
+
+#endif // PATTERNBANK_H_INCLUDED
@@ -0,0 +1,38 @@
+#ifndef POOLSTATS_H_INCLUDED
+#define POOLSTATS_H_INCLUDED
+
+// What fixed-capacity storage does when every slot is in use.
+enum PoolOverflowPolicy
+{
+	POOL_OVERFLOW_GROW,		// Let the storage reallocate past its capacity
+	POOL_OVERFLOW_FAIL		// Refuse; the caller gets nothing back
+};
+
+struct PoolStats
+{
+	PoolStats() :
+		capacity(0),
+		live(0),
+		highWaterMark(0),
+		overflows(0)
+	{
+	}
+
+	void OnAdd()
+	{
+		if (++live > highWaterMark)
+			highWaterMark = live;
+	}
+
+	void OnRemove()
+	{
+		--live;
+	}
+
+	unsigned int capacity;
+	unsigned int live;
+	unsigned int highWaterMark;
+	unsigned int overflows;
+};
+
+#endif // POOLSTATS_H_INCLUDED
@@ -0,0 +1,204 @@
+#include "Random.h"
+#include "MotionKernels.h"
+#include "SimdSupport.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+	uint32_t RotateLeft(uint32_t value, int bits)
+	{
+		return (value << bits) | (value >> (32 - bits));
+	}
+
+	// Spreads a 64 bit seed over the generator's state
+	uint64_t SplitMix64(uint64_t *state)
+	{
+		uint64_t value = (*state += 0x9e3779b97f4a7c15ULL);
+		value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+		return value ^ (value >> 31);
+	}
+
+	// The top 23 bits as the mantissa of a float in [1, 2), less one
+	float ToUnitFloat(uint32_t bits)
+	{
+		uint32_t pattern = (bits >> 9) | 0x3f800000U;
+		float value;
+		std::memcpy(&value, &pattern, sizeof(value));
+		return value - 1.0f;
+	}
+
+	void ToFloatsScalar(const uint32_t *bits, unsigned int count, float min, float range, float *values)
+	{
+		for (unsigned int index = 0; index < count; ++index)
+		{
+			values[index] = min + ToUnitFloat(bits[index]) * range;
+		}
+	}
+
+#if defined(SIMD_X86)
+	void ToFloatsSSE2(const uint32_t *bits, unsigned int count, float min, float range, float *values)
+	{
+		const __m128i exponent = _mm_set1_epi32(0x3f800000);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 minimum = _mm_set1_ps(min);
+		const __m128 width = _mm_set1_ps(range);
+
+		unsigned int index = 0;
+		for (; index + 4 <= count; index += 4)
+		{
+			__m128i pattern = _mm_or_si128(_mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bits + index)), 9), exponent);
+			__m128 unit = _mm_sub_ps(_mm_castsi128_ps(pattern), one);
+			_mm_storeu_ps(values + index, _mm_add_ps(minimum, _mm_mul_ps(unit, width)));
+		}
+
+		ToFloatsScalar(bits + index, count - index, min, range, values + index);
+	}
+#endif
+
+	std::mutex sharedMutex;
+	Random sharedGenerator;
+}
+
+Random::Random(uint64_t seed)
+{
+	Seed(seed);
+}
+
+void Random::Seed(uint64_t seed)
+{
+	uint64_t mix = seed;
+	uint64_t low = SplitMix64(&mix);
+	uint64_t high = SplitMix64(&mix);
+	state_[0] = static_cast<uint32_t>(low);
+	state_[1] = static_cast<uint32_t>(low >> 32);
+	state_[2] = static_cast<uint32_t>(high);
+	state_[3] = static_cast<uint32_t>(high >> 32);
+}
+
+uint32_t Random::NextUint()
+{
+	uint32_t result = state_[0] + state_[3];
+	uint32_t shifted = state_[1] << 9;
+
+	state_[2] ^= state_[0];
+	state_[3] ^= state_[1];
+	state_[1] ^= state_[2];
+	state_[0] ^= state_[3];
+	state_[2] ^= shifted;
+	state_[3] = RotateLeft(state_[3], 11);
+	return result;
+}
+
+float Random::NextFloat()
+{
+	return ToUnitFloat(NextUint());
+}
+
+float Random::NextFloat(float max)
+{
+	return NextFloat() * max;
+}
+
+float Random::NextFloat(float min, float max)
+{
+	return min + NextFloat() * (max - min);
+}
+
+void Random::Fill(float *values, unsigned int count, float min, float max)
+{
+	const unsigned int BLOCK_SIZE = 64;
+	uint32_t bits[BLOCK_SIZE];
+	float range = max - min;
+
+	for (unsigned int begin = 0; begin < count; begin += BLOCK_SIZE)
+	{
+		unsigned int blockCount = std::min(BLOCK_SIZE, count - begin);
+		for (unsigned int index = 0; index < blockCount; ++index)
+		{
+			bits[index] = NextUint();
+		}
+
+#if defined(SIMD_X86)
+		if (MotionKernels::GetPath() != MotionKernels::PATH_SCALAR)
+		{
+			ToFloatsSSE2(bits, blockCount, min, range, values + begin);
+			continue;
+		}
+#endif
+		ToFloatsScalar(bits, blockCount, min, range, values + begin);
+	}
+}
+
+void Random::Jump()
+{
+	static const uint32_t JUMP[4] = { 0x8764000bU, 0xf542d2d3U, 0x6fa035c3U, 0x77f2db5bU };
+
+	uint32_t jumped[4] = { 0, 0, 0, 0 };
+	for (int word = 0; word < 4; ++word)
+	{
+		for (int bit = 0; bit < 32; ++bit)
+		{
+			if (JUMP[word] & (1U << bit))
+			{
+				jumped[0] ^= state_[0];
+				jumped[1] ^= state_[1];
+				jumped[2] ^= state_[2];
+				jumped[3] ^= state_[3];
+			}
+			NextUint();
+		}
+	}
+
+	state_[0] = jumped[0];
+	state_[1] = jumped[1];
+	state_[2] = jumped[2];
+	state_[3] = jumped[3];
+}
+
+Random Random::Split()
+{
+	Random stream = *this;
+	Jump();
+	return stream;
+}
+
+float Random::GetFloat(float max)
+{
+	return GetThreadGenerator().NextFloat(max);
+}
+
+float Random::GetFloat(float min, float max)
+{
+	return GetThreadGenerator().NextFloat(min, max);
+}
+
+Random &Random::GetThreadGenerator()
+{
+	struct ThreadGenerator
+	{
+		ThreadGenerator()
+		{
+			std::lock_guard<std::mutex> lock(sharedMutex);
+			generator = sharedGenerator.Split();
+		}
+
+		Random generator;
+	};
+
+	thread_local ThreadGenerator threadGenerator;
+	return threadGenerator.generator;
+}
+
+// Two multiply-xorshift rounds; every input bit reaches every output bit
+uint32_t Random::Hash(uint32_t key)
+{
+	key ^= key >> 16;
+	key *= 0x7feb352dU;
+	key ^= key >> 15;
+	key *= 0x846ca68bU;
+	key ^= key >> 16;
+	return key;
+}
@@ -0,0 +1,49 @@
+#ifndef RANDOM_H_INCLUDED
+#define RANDOM_H_INCLUDED
+
+#include <stdint.h>
+
+// xoshiro128+ generator. It is seeded explicitly, so a given seed draws the
+// same sequence on every platform, and it is cheap to copy. Independent
+// streams for threads or subsystems come from Jump() or Split(): each moves
+// a stream on 2^64 draws, further than any run will get. A generator is not
+// safe to share between threads; give each its own.
+//
+// The static GetFloat functions draw on a generator belonging to the calling
+// thread, split from a shared one the first time the thread asks. They are
+// for effects that need not be reproducible; anything that must replay the
+// same should own a generator.
+class Random
+{
+public:
+	static const uint64_t DEFAULT_SEED = 1;
+
+	explicit Random(uint64_t seed = DEFAULT_SEED);
+
+	void Seed(uint64_t seed);
+
+	uint32_t NextUint();
+	// In [0, 1)
+	float NextFloat();
+	float NextFloat(float max);
+	float NextFloat(float min, float max);
+	// The same values as count calls to NextFloat(min, max), converted to
+	// floats a block at a time with SIMD where the CPU has it
+	void Fill(float *values, unsigned int count, float min, float max);
+
+	void Jump();
+	// A copy of this stream as it is; this one then jumps ahead of it
+	Random Split();
+
+	static float GetFloat(float max);
+	static float GetFloat(float min, float max);
+	static Random &GetThreadGenerator();
+
+	// Stateless: the same key always gives the same value, on any thread
+	static uint32_t Hash(uint32_t key);
+
+private:
+	uint32_t state_[4];
+};
+
+#endif // RANDOM_H_INCLUDED
@@ -0,0 +1,149 @@
+#include "Ship.h"
+#include "Maths.h"
+#include "SimClock.h"
+#include <algorithm>
+#include <cmath>
+
+Ship::Ship() :
+	lives_(1),
+	accelerationControl_(0.0f),
+	rotationControl_(0.0f),
+	velocity_(XMFLOAT3(0.0f, 0.0f, 0.0f)),
+	forward_(XMFLOAT3(0.0f, 1.0f, 0.0f)),
+	rotation_(0.0f),
+	color_(XMVectorSet(1.f, 1.f, 1.f, 1.f)),
+	coolDown_(0.f),
+	timeSinceShot_(0.f),
+	shotReady_(false),
+	fireMode_(FireMode::SINGLE)//**TODO: Candidate for crash
+{
+}
+
+void Ship::SetControlInput(float acceleration,
+	float rotation)
+{
+	accelerationControl_ = acceleration;
+	rotationControl_ = rotation;
+}
+
+void Ship::Update(const SimClock &clock)
+{
+	if (!shotReady_)
+	{
+		timeSinceShot_ += clock.GetTickSeconds();
+		if (timeSinceShot_ > coolDown_)
+		{
+			shotReady_ = true;
+		}
+	}
+
+	const float RATE_OF_ROTATION = 0.1f;
+	const float MAX_SPEED = 2.0f;
+	const float VELOCITY_TWEEN = 0.05f;
+
+	//Rates are per default-length tick; a longer tick covers several
+	float stepScale = clock.GetStepScale();
+	float tween = 1.0f - std::pow(1.0f - VELOCITY_TWEEN, stepScale);
+
+	rotation_ = Maths::WrapModulo(rotation_ + rotationControl_ * RATE_OF_ROTATION * stepScale,
+		Maths::TWO_PI);
+
+	XMMATRIX rotationMatrix = XMMatrixRotationZ(rotation_);
+	XMVECTOR newForward = XMVector3TransformNormal(XMVectorSet(0.f, 1.0f, 0.0f, 0.0f), rotationMatrix);
+	newForward = XMVector3Normalize(newForward);
+	XMStoreFloat3(&forward_, newForward);
+
+	XMVECTOR idealVelocity = XMVectorScale(XMLoadFloat3(&forward_), accelerationControl_ * MAX_SPEED);
+	XMVECTOR newVelocity = XMVectorLerp(XMLoadFloat3(&velocity_), idealVelocity, tween);
+	XMStoreFloat3(&velocity_, newVelocity);
+
+	XMVECTOR position = GetPosition();
+	position = XMVectorAdd(position, XMLoadFloat3(&velocity_) * stepScale);
+	SetPosition(position);
+}
+
+void Ship::SetNumLives(int lives)
+{
+	lives_ = lives;
+}
+
+int Ship::GetNumLives() const
+{
+	return lives_;
+}
+
+void Ship::TakeLife()
+{
+	if (--lives_ > 0)
+	{
+		Reset();
+	}
+	else
+	{
+		SetAlive(false);
+	}
+}
+
+XMVECTOR Ship::GetForwardVector() const
+{
+	return XMLoadFloat3(&forward_);
+}
+
+XMVECTOR Ship::GetVelocity() const
+{
+	return XMLoadFloat3(&velocity_);
+}
+
+float Ship::GetRotation() const
+{
+	return rotation_;
+}
+
+bool Ship::IsThrusting() const
+{
+	return accelerationControl_ != 0.0f;
+}
+
+const Ship::FireMode Ship::GetFireMode() const
+{
+	return fireMode_;
+}
+
+void Ship::SetFireMode(FireMode fireMode)
+{
+	fireMode_ = fireMode;
+}
+
+bool Ship::ReadyToShoot() const
+{
+	return shotReady_;
+}
+
+void Ship::SetCooldown(float coolDown)
+{
+	coolDown_ = coolDown;
+}
+
+void Ship::DisableShooting()
+{
+	shotReady_ = false;
+	timeSinceShot_ = 0.f;
+}
+
+void Ship::SetColor(const XMVECTOR& color)
+{
+	color_ = color;
+}
+
+void Ship::Reset()
+{
+	accelerationControl_ = 0.0f;
+	rotationControl_ = 0.0f;
+
+	fireMode_ = FireMode::SINGLE;
+	velocity_ = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	forward_ = XMFLOAT3(0.0f, 1.0f, 0.0f);
+	rotation_ = 0.0f;
+
+	SetPosition(XMVectorZero());
+}
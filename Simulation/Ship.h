@@ -1,11 +1,8 @@
 #ifndef SHIP_H_INCLUDED
 #define SHIP_H_INCLUDED
 
-#include <ctime>
 #include "GameEntity.h"
 
-class Graphics;
-
 class Ship : public GameEntity
 {
 public:
@@ -22,11 +19,12 @@ public:
 	void SetControlInput(float acceleration,
 		float rotation);
 
-	void Update(System *system);
-	void Render(Graphics *graphics) const;
+	void Update(const SimClock &clock);
 
 	XMVECTOR GetForwardVector() const;
 	XMVECTOR GetVelocity() const;
+	float GetRotation() const;
+	bool IsThrusting() const;
 
 	bool ReadyToShoot() const;
 	void SetCooldown(float cooldown);
@@ -45,7 +43,7 @@ public:
 
 protected:
 	float coolDown_;
-	std::clock_t lastShotTime_;
+	float timeSinceShot_;
 	bool shotReady_;
 
 private:
@@ -0,0 +1,71 @@
+#include "SimClock.h"
+
+const float SimClock::DEFAULT_TICK_SECONDS = 1.0f / 60.0f;
+
+SimClock::SimClock(float tickSeconds, unsigned int maxCatchUpTicks) :
+	tickSeconds_(tickSeconds),
+	maxCatchUpTicks_(maxCatchUpTicks),
+	accumulator_(0.0),
+	tickCount_(0)
+{
+}
+
+unsigned int SimClock::Accumulate(double realSeconds)
+{
+	if (realSeconds > 0.0)
+	{
+		accumulator_ += realSeconds;
+	}
+
+	unsigned int ticks = static_cast<unsigned int>(accumulator_ / tickSeconds_);
+	if (ticks > maxCatchUpTicks_)
+	{
+		// Too far behind; run what we are allowed to and forget the rest
+		ticks = maxCatchUpTicks_;
+		accumulator_ = ticks * static_cast<double>(tickSeconds_);
+	}
+
+	accumulator_ -= ticks * static_cast<double>(tickSeconds_);
+	return ticks;
+}
+
+void SimClock::Tick()
+{
+	++tickCount_;
+}
+
+void SimClock::Reset()
+{
+	accumulator_ = 0.0;
+	tickCount_ = 0;
+}
+
+float SimClock::GetTickSeconds() const
+{
+	return tickSeconds_;
+}
+
+void SimClock::SetTickSeconds(float tickSeconds)
+{
+	tickSeconds_ = tickSeconds;
+}
+
+float SimClock::GetStepScale() const
+{
+	return tickSeconds_ / DEFAULT_TICK_SECONDS;
+}
+
+double SimClock::GetTime() const
+{
+	return tickCount_ * static_cast<double>(tickSeconds_);
+}
+
+uint64_t SimClock::GetTickCount() const
+{
+	return tickCount_;
+}
+
+float SimClock::GetInterpolationAlpha() const
+{
+	return static_cast<float>(accumulator_ / tickSeconds_);
+}
@@ -0,0 +1,39 @@
+#ifndef SIMCLOCK_H_INCLUDED
+#define SIMCLOCK_H_INCLUDED
+
+#include <stdint.h>
+
+// Fixed-step simulation clock. Real elapsed time is fed into an accumulator
+// and paid out as whole ticks of TickSeconds; anything beyond the catch-up
+// limit is dropped so a long stall cannot spiral. The fraction left in the
+// accumulator is exposed as an interpolation alpha for rendering. Rates
+// given per tick are tuned for ticks of DEFAULT_TICK_SECONDS and multiplied
+// by GetStepScale() to cover a tick of any other length.
+class SimClock
+{
+public:
+	static const float DEFAULT_TICK_SECONDS;
+	static const unsigned int DEFAULT_MAX_CATCH_UP_TICKS = 5;
+
+	SimClock(float tickSeconds = DEFAULT_TICK_SECONDS,
+		unsigned int maxCatchUpTicks = DEFAULT_MAX_CATCH_UP_TICKS);
+
+	unsigned int Accumulate(double realSeconds);
+	void Tick();
+	void Reset();
+
+	float GetTickSeconds() const;
+	void SetTickSeconds(float tickSeconds);
+	float GetStepScale() const;
+	double GetTime() const;
+	uint64_t GetTickCount() const;
+	float GetInterpolationAlpha() const;
+
+private:
+	float tickSeconds_;
+	unsigned int maxCatchUpTicks_;
+	double accumulator_;
+	uint64_t tickCount_;
+};
+
+#endif // SIMCLOCK_H_INCLUDED
@@ -0,0 +1,31 @@
+#ifndef SIMDSUPPORT_H_INCLUDED
+#define SIMDSUPPORT_H_INCLUDED
+
+// Shared by the batch kernels. SIMD_X86 is defined where the SSE2 and AVX2
+// paths can be compiled; functions using AVX2 are marked SIMD_AVX2_TARGET.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SIMD_AVX2_TARGET
+#else
+#include <cpuid.h>
+#define SIMD_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+#if defined(SIMD_X86)
+
+// SSE2 has no floor; truncate and step down where that rounded up.
+// Good for |x| < 2^31, far beyond how many times a value can wrap.
+inline __m128 FloorSSE2(__m128 x)
+{
+	__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+	__m128 roundedUp = _mm_cmpgt_ps(truncated, x);
+	return _mm_sub_ps(truncated, _mm_and_ps(roundedUp, _mm_set1_ps(1.0f)));
+}
+
+#endif
+
+#endif // SIMDSUPPORT_H_INCLUDED
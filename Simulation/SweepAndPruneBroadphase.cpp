@@ -0,0 +1,167 @@
+#include "SweepAndPruneBroadphase.h"
+#include "MotionKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const unsigned int NOT_PRESENT = 0xffffffff;
+	const unsigned int POSITIONS_PER_CHUNK = 256;
+}
+
+SweepAndPruneBroadphase::SweepAndPruneBroadphase()
+{
+}
+
+void SweepAndPruneBroadphase::FindPairs(const BroadphaseInput &input,
+	JobSystem *jobs,
+	std::vector<ColliderPair> *pairs)
+{
+	UpdateOrder(input);
+	SortOrder();
+
+	FindPairsInChunks(jobs, static_cast<unsigned int>(order_.size()), POSITIONS_PER_CHUNK,
+		[this, &input](unsigned int begin, unsigned int end, std::vector<ColliderPair> *chunkPairs)
+		{
+			Sweep(input, begin, end, chunkPairs);
+		},
+		pairs);
+
+	// Overlaps can be found from both ends
+	std::sort(pairs->begin(), pairs->end(), ColliderPairLess);
+	pairs->erase(std::unique(pairs->begin(), pairs->end(), ColliderPairEqual), pairs->end());
+}
+
+// Sweeps forward from the sorted positions in [begin, end)
+void SweepAndPruneBroadphase::Sweep(const BroadphaseInput &input, unsigned int begin, unsigned int end,
+	std::vector<ColliderPair> *pairs) const
+{
+	const WorldBounds &bounds = input.bounds;
+	float width = bounds.GetWidth();
+	float height = bounds.GetHeight();
+	float inverseHeight = 1.0f / height;
+	unsigned int count = static_cast<unsigned int>(order_.size());
+
+	for (unsigned int position = begin; position < end; ++position)
+	{
+		unsigned int a = packedIndex_[order_[position]];
+		float left = left_[position];
+		float extent = 2.0f * input.radius[a];
+
+		// Everything whose left edge falls inside this one's bounds, going
+		// round the end of the list with the world
+		for (unsigned int step = 1; step < count; ++step)
+		{
+			unsigned int next = position + step;
+			float nextLeft;
+			if (next < count)
+			{
+				nextLeft = left_[next];
+			}
+			else
+			{
+				next -= count;
+				nextLeft = left_[next] + width;
+			}
+
+			if (nextLeft - left > extent)
+				break;
+
+			unsigned int b = packedIndex_[order_[next]];
+			if (!LayersCollide(input, a, b))
+				continue;
+
+			float dy = MotionKernels::WrapDelta(input.positionY[a] - input.positionY[b], height, inverseHeight);
+			if (std::fabs(dy) > input.radius[a] + input.radius[b])
+				continue;
+
+			ColliderPair pair;
+			pair.a = std::min(a, b);
+			pair.b = std::max(a, b);
+			pairs->push_back(pair);
+		}
+	}
+}
+
+void SweepAndPruneBroadphase::UpdateOrder(const BroadphaseInput &input)
+{
+	unsigned int maxProxyId = 0;
+	for (unsigned int index = 0; index < input.count; ++index)
+	{
+		maxProxyId = std::max(maxProxyId, input.proxyId[index] + 1);
+	}
+	if (packedIndex_.size() < maxProxyId)
+	{
+		packedIndex_.resize(maxProxyId, NOT_PRESENT);
+		inOrder_.resize(maxProxyId, 0);
+	}
+
+	for (std::vector<unsigned int>::const_iterator proxyIt = order_.begin(), end = order_.end();
+		proxyIt != end;
+		++proxyIt)
+	{
+		packedIndex_[*proxyIt] = NOT_PRESENT;
+	}
+
+	for (unsigned int index = 0; index < input.count; ++index)
+	{
+		packedIndex_[input.proxyId[index]] = index;
+	}
+
+	// Drop proxies that have gone, keeping the survivors' order
+	unsigned int kept = 0;
+	for (unsigned int position = 0; position < order_.size(); ++position)
+	{
+		unsigned int proxyId = order_[position];
+		if (packedIndex_[proxyId] != NOT_PRESENT)
+		{
+			order_[kept++] = proxyId;
+		}
+		else
+		{
+			inOrder_[proxyId] = 0;
+		}
+	}
+	order_.resize(kept);
+
+	// New proxies go on the end and get sorted into place
+	for (unsigned int index = 0; index < input.count; ++index)
+	{
+		unsigned int proxyId = input.proxyId[index];
+		if (!inOrder_[proxyId])
+		{
+			inOrder_[proxyId] = 1;
+			order_.push_back(proxyId);
+		}
+	}
+
+	const WorldBounds &bounds = input.bounds;
+	left_.resize(order_.size());
+	for (unsigned int position = 0; position < order_.size(); ++position)
+	{
+		unsigned int index = packedIndex_[order_[position]];
+		left_[position] = MotionKernels::WrapValue(input.positionX[index] - input.radius[index],
+			bounds.minX, bounds.maxX);
+	}
+}
+
+void SweepAndPruneBroadphase::SortOrder()
+{
+	unsigned int count = static_cast<unsigned int>(order_.size());
+	for (unsigned int position = 1; position < count; ++position)
+	{
+		float left = left_[position];
+		unsigned int proxyId = order_[position];
+
+		unsigned int insert = position;
+		while (insert > 0 && left_[insert - 1] > left)
+		{
+			left_[insert] = left_[insert - 1];
+			order_[insert] = order_[insert - 1];
+			--insert;
+		}
+
+		left_[insert] = left;
+		order_[insert] = proxyId;
+	}
+}
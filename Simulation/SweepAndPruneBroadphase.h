@@ -0,0 +1,37 @@
+#ifndef SWEEPANDPRUNEBROADPHASE_H_INCLUDED
+#define SWEEPANDPRUNEBROADPHASE_H_INCLUDED
+
+#include <vector>
+#include "Broadphase.h"
+
+// Sweep and prune along x. The colliders stay sorted by the left edge of
+// their bounds from one pass to the next, keyed by proxy id, and are re-sorted
+// with an insertion sort; things move a little each tick so that is close to
+// linear. The x axis is treated as a circle so bounds crossing the world edge
+// overlap things at the far side, and y is compared on the wrapped world too.
+// The sweep runs over runs of sorted positions that can go in parallel.
+class SweepAndPruneBroadphase : public Broadphase
+{
+public:
+	SweepAndPruneBroadphase();
+
+	void FindPairs(const BroadphaseInput &input,
+		JobSystem *jobs,
+		std::vector<ColliderPair> *pairs);
+
+private:
+	void UpdateOrder(const BroadphaseInput &input);
+	void SortOrder();
+	void Sweep(const BroadphaseInput &input, unsigned int begin, unsigned int end,
+		std::vector<ColliderPair> *pairs) const;
+
+	// Proxy ids sorted by left edge, with the edges alongside
+	std::vector<unsigned int> order_;
+	std::vector<float> left_;
+
+	// Packed index of each proxy id this pass, all ones if absent
+	std::vector<unsigned int> packedIndex_;
+	std::vector<unsigned char> inOrder_;
+};
+
+#endif // SWEEPANDPRUNEBROADPHASE_H_INCLUDED
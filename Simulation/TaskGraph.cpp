@@ -0,0 +1,93 @@
+#include "TaskGraph.h"
+#include "JobSystem.h"
+#include <cassert>
+
+TaskGraph::TaskGraph() :
+	waitingOn_(nullptr),
+	jobs_(nullptr),
+	counter_(nullptr)
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+	delete [] waitingOn_;
+}
+
+TaskGraph::TaskId TaskGraph::AddTask(const TaskFunction &function)
+{
+	Task task;
+	task.function = function;
+	task.numDependencies = 0;
+	tasks_.push_back(task);
+
+	delete [] waitingOn_;
+	waitingOn_ = new std::atomic<unsigned int>[tasks_.size()];
+
+	return static_cast<TaskId>(tasks_.size() - 1);
+}
+
+void TaskGraph::AddDependency(TaskId before, TaskId after)
+{
+	assert(before < after);
+	tasks_[before].dependents.push_back(after);
+	++tasks_[after].numDependencies;
+}
+
+void TaskGraph::Run(JobSystem *jobs)
+{
+	if (jobs == nullptr)
+	{
+		// Dependencies always point forwards, so insertion order is valid
+		for (std::vector<Task>::iterator taskIt = tasks_.begin(), end = tasks_.end();
+			taskIt != end;
+			++taskIt)
+		{
+			taskIt->function();
+		}
+		return;
+	}
+
+	for (TaskId taskId = 0; taskId < tasks_.size(); ++taskId)
+	{
+		waitingOn_[taskId].store(tasks_[taskId].numDependencies);
+	}
+
+	JobCounter counter;
+	jobs_ = jobs;
+	counter_ = &counter;
+
+	for (TaskId taskId = 0; taskId < tasks_.size(); ++taskId)
+	{
+		if (tasks_[taskId].numDependencies == 0)
+		{
+			Submit(taskId);
+		}
+	}
+
+	jobs->Wait(&counter);
+	jobs_ = nullptr;
+	counter_ = nullptr;
+}
+
+void TaskGraph::Submit(TaskId taskId)
+{
+	jobs_->Run([this, taskId]() { Execute(taskId); }, counter_);
+}
+
+void TaskGraph::Execute(TaskId taskId)
+{
+	const Task &task = tasks_[taskId];
+	task.function();
+
+	// Whoever finishes the last dependency releases the dependent
+	for (std::vector<TaskId>::const_iterator dependentIt = task.dependents.begin(), end = task.dependents.end();
+		dependentIt != end;
+		++dependentIt)
+	{
+		if (waitingOn_[*dependentIt].fetch_sub(1) == 1)
+		{
+			Submit(*dependentIt);
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#ifndef TASKGRAPH_H_INCLUDED
+#define TASKGRAPH_H_INCLUDED
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+class JobSystem;
+struct JobCounter;
+
+// A fixed set of tasks with ordering constraints, built once and run every
+// frame. Run() submits each task to the job system as soon as everything it
+// depends on has finished; without a job system the tasks run in order on
+// the calling thread. Dependencies must be added from earlier to later tasks.
+class TaskGraph
+{
+public:
+	typedef unsigned int TaskId;
+	typedef std::function<void()> TaskFunction;
+
+	TaskGraph();
+	~TaskGraph();
+
+	TaskId AddTask(const TaskFunction &function);
+	void AddDependency(TaskId before, TaskId after);
+
+	void Run(JobSystem *jobs);
+
+private:
+	TaskGraph(const TaskGraph &);
+	void operator=(const TaskGraph &);
+
+	struct Task
+	{
+		TaskFunction function;
+		std::vector<TaskId> dependents;
+		unsigned int numDependencies;
+	};
+
+	void Submit(TaskId taskId);
+	void Execute(TaskId taskId);
+
+	std::vector<Task> tasks_;
+	std::atomic<unsigned int> *waitingOn_;
+
+	// Only valid during Run()
+	JobSystem *jobs_;
+	JobCounter *counter_;
+};
+
+#endif // TASKGRAPH_H_INCLUDED
@@ -0,0 +1,40 @@
+#include "UFO.h"
+#include "Maths.h"
+#include "SimClock.h"
+
+
+UFO::UFO(int speed)
+{
+	speed_ = 20.f * speed;
+	DisableShooting();
+	SetCooldown(Maths::WrapModulo(8 - speed, 1.f, 7.f));
+	SetPosition(XMVectorSet(-400.0f, 250.0f, 0.0f, 0.0f));
+}
+
+
+UFO::~UFO(void)
+{
+}
+
+void UFO::Update(const SimClock &clock)
+{
+	float deltaTime = clock.GetTickSeconds();
+
+	if(!shotReady_)
+	{
+		timeSinceShot_ += deltaTime;
+		if(timeSinceShot_ > coolDown_)
+		{
+			shotReady_ = true;
+		}
+	}
+
+	XMVECTOR position = GetPosition();
+	SetPosition(XMVectorSetX(position, XMVectorGetX(position) + speed_ * deltaTime));
+}
+
+void UFO::Reset()
+{
+	timeSinceShot_ = coolDown_;
+	SetPosition(XMVectorSet(-400.0f, 250.0f, 0.0f, 0.0f));
+}
\ No newline at end of file
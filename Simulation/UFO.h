@@ -1,5 +1,5 @@
 #pragma once
-#include "ship.h"
+#include "Ship.h"
 class UFO :
 	public Ship
 {
@@ -7,13 +7,11 @@ public:
 	UFO(int speed);
 	~UFO(void);
 
-	void Update(System* system);
-	void Render(Graphics* graphics) const;
+	void Update(const SimClock &clock);
 
 	void Reset();
 
 private:
 	float speed_;
-	std::clock_t startFrameTime_;
 };
 
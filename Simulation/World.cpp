@@ -0,0 +1,274 @@
+#include "World.h"
+#include <utility>
+
+namespace
+{
+	// Moves the last element of an array into slot index and drops the tail.
+	template <typename T>
+	void SwapAndPop(std::vector<T> &values, unsigned int index)
+	{
+		if (index + 1 != values.size())
+		{
+			values[index] = std::move(values.back());
+		}
+		values.pop_back();
+	}
+
+	template <typename T>
+	void ReserveArray(std::vector<T> &values, unsigned int capacity)
+	{
+		values.reserve(capacity);
+	}
+
+	// Records an Add against the stats; going past capacity means the
+	// arrays are about to reallocate.
+	void CountAdd(PoolStats &stats, unsigned int size)
+	{
+		if (size >= stats.capacity)
+		{
+			++stats.overflows;
+		}
+		stats.OnAdd();
+	}
+}
+
+World::World(PoolOverflowPolicy overflowPolicy)
+{
+	asteroids.Reserve(MAX_ASTEROIDS, overflowPolicy);
+	bullets.Reserve(MAX_BULLETS, overflowPolicy);
+	explosions.Reserve(MAX_EXPLOSIONS, overflowPolicy);
+	particles.Reserve(MAX_EXPLOSIONS);
+}
+
+unsigned int World::AsteroidArrays::Add(float x, float y,
+	float vx, float vy,
+	const XMFLOAT3 &rotationAxis,
+	float rotationSpeed,
+	int asteroidSize)
+{
+	unsigned int index = Size();
+	CountAdd(stats, index);
+
+	positionX.push_back(x);
+	positionY.push_back(y);
+	velocityX.push_back(vx);
+	velocityY.push_back(vy);
+	axis.push_back(rotationAxis);
+	angle.push_back(0.0f);
+	angularSpeed.push_back(rotationSpeed);
+	size.push_back(asteroidSize);
+	alive.push_back(1);
+	collider.push_back(ColliderHandle());
+	handle.push_back(handles.Create(index));
+	return index;
+}
+
+void World::AsteroidArrays::Remove(unsigned int index)
+{
+	stats.OnRemove();
+	handles.Destroy(handle[index]);
+	SwapAndPop(positionX, index);
+	SwapAndPop(positionY, index);
+	SwapAndPop(velocityX, index);
+	SwapAndPop(velocityY, index);
+	SwapAndPop(axis, index);
+	SwapAndPop(angle, index);
+	SwapAndPop(angularSpeed, index);
+	SwapAndPop(size, index);
+	SwapAndPop(alive, index);
+	SwapAndPop(collider, index);
+	SwapAndPop(handle, index);
+
+	if (index < Size())
+	{
+		handles.Move(handle[index], index);
+	}
+}
+
+void World::AsteroidArrays::Clear()
+{
+	positionX.clear();
+	positionY.clear();
+	velocityX.clear();
+	velocityY.clear();
+	axis.clear();
+	angle.clear();
+	angularSpeed.clear();
+	size.clear();
+	alive.clear();
+	collider.clear();
+	handle.clear();
+	handles.Clear();
+	stats.live = 0;
+}
+
+unsigned int World::AsteroidArrays::Size() const
+{
+	return static_cast<unsigned int>(positionX.size());
+}
+
+void World::AsteroidArrays::Reserve(unsigned int capacity, PoolOverflowPolicy overflowPolicy)
+{
+	ReserveArray(positionX, capacity);
+	ReserveArray(positionY, capacity);
+	ReserveArray(velocityX, capacity);
+	ReserveArray(velocityY, capacity);
+	ReserveArray(axis, capacity);
+	ReserveArray(angle, capacity);
+	ReserveArray(angularSpeed, capacity);
+	ReserveArray(size, capacity);
+	ReserveArray(alive, capacity);
+	ReserveArray(collider, capacity);
+	ReserveArray(handle, capacity);
+	handles.Reserve(capacity);
+	policy = overflowPolicy;
+	stats.capacity = capacity;
+}
+
+bool World::AsteroidArrays::CanAdd() const
+{
+	return policy == POOL_OVERFLOW_GROW || Size() < stats.capacity;
+}
+
+unsigned int World::BulletArrays::Add(Owner bulletOwner,
+	float x, float y,
+	float vx, float vy,
+	float life)
+{
+	unsigned int index = Size();
+	CountAdd(stats, index);
+
+	positionX.push_back(x);
+	positionY.push_back(y);
+	velocityX.push_back(vx);
+	velocityY.push_back(vy);
+	lifeTime.push_back(life);
+	age.push_back(0.0f);
+	owner.push_back(bulletOwner);
+	alive.push_back(1);
+	collider.push_back(ColliderHandle());
+	handle.push_back(handles.Create(index));
+	return index;
+}
+
+void World::BulletArrays::Remove(unsigned int index)
+{
+	stats.OnRemove();
+	handles.Destroy(handle[index]);
+	SwapAndPop(positionX, index);
+	SwapAndPop(positionY, index);
+	SwapAndPop(velocityX, index);
+	SwapAndPop(velocityY, index);
+	SwapAndPop(lifeTime, index);
+	SwapAndPop(age, index);
+	SwapAndPop(owner, index);
+	SwapAndPop(alive, index);
+	SwapAndPop(collider, index);
+	SwapAndPop(handle, index);
+
+	if (index < Size())
+	{
+		handles.Move(handle[index], index);
+	}
+}
+
+void World::BulletArrays::Clear()
+{
+	positionX.clear();
+	positionY.clear();
+	velocityX.clear();
+	velocityY.clear();
+	lifeTime.clear();
+	age.clear();
+	owner.clear();
+	alive.clear();
+	collider.clear();
+	handle.clear();
+	handles.Clear();
+	stats.live = 0;
+}
+
+unsigned int World::BulletArrays::Size() const
+{
+	return static_cast<unsigned int>(positionX.size());
+}
+
+void World::BulletArrays::Reserve(unsigned int capacity, PoolOverflowPolicy overflowPolicy)
+{
+	ReserveArray(positionX, capacity);
+	ReserveArray(positionY, capacity);
+	ReserveArray(velocityX, capacity);
+	ReserveArray(velocityY, capacity);
+	ReserveArray(lifeTime, capacity);
+	ReserveArray(age, capacity);
+	ReserveArray(owner, capacity);
+	ReserveArray(alive, capacity);
+	ReserveArray(collider, capacity);
+	ReserveArray(handle, capacity);
+	handles.Reserve(capacity);
+	policy = overflowPolicy;
+	stats.capacity = capacity;
+}
+
+bool World::BulletArrays::CanAdd() const
+{
+	return policy == POOL_OVERFLOW_GROW || Size() < stats.capacity;
+}
+
+unsigned int World::ExplosionArrays::Add(float x, float y, unsigned int particleEmitter)
+{
+	unsigned int index = Size();
+	CountAdd(stats, index);
+
+	positionX.push_back(x);
+	positionY.push_back(y);
+	emitter.push_back(particleEmitter);
+	alive.push_back(1);
+	return index;
+}
+
+void World::ExplosionArrays::Remove(unsigned int index)
+{
+	stats.OnRemove();
+	SwapAndPop(positionX, index);
+	SwapAndPop(positionY, index);
+	SwapAndPop(emitter, index);
+	SwapAndPop(alive, index);
+}
+
+void World::ExplosionArrays::Clear()
+{
+	positionX.clear();
+	positionY.clear();
+	emitter.clear();
+	alive.clear();
+	stats.live = 0;
+}
+
+unsigned int World::ExplosionArrays::Size() const
+{
+	return static_cast<unsigned int>(positionX.size());
+}
+
+void World::ExplosionArrays::Reserve(unsigned int capacity, PoolOverflowPolicy overflowPolicy)
+{
+	ReserveArray(positionX, capacity);
+	ReserveArray(positionY, capacity);
+	ReserveArray(emitter, capacity);
+	ReserveArray(alive, capacity);
+	policy = overflowPolicy;
+	stats.capacity = capacity;
+}
+
+bool World::ExplosionArrays::CanAdd() const
+{
+	return policy == POOL_OVERFLOW_GROW || Size() < stats.capacity;
+}
+
+void World::Clear()
+{
+	asteroids.Clear();
+	bullets.Clear();
+	explosions.Clear();
+	particles.Clear();
+}
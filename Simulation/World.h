@@ -0,0 +1,121 @@
+#ifndef WORLD_H_INCLUDED
+#define WORLD_H_INCLUDED
+
+#include <DirectXMath.h>
+#include <vector>
+#include <stdint.h>
+#include "HandleRegistry.h"
+#include "PoolStats.h"
+#include "ParticleSystem.h"
+
+using namespace DirectX;
+
+
+enum Owner
+{
+	Player,
+	Enemy
+};
+
+// Structure-of-arrays storage for the short lived entities. Each entity kind
+// keeps one packed array per field; removal swaps the last entity into the
+// hole so the arrays stay dense and update passes are simple linear loops.
+// Indices are therefore only stable until the next Remove(); collidable kinds
+// also hand out generational handles that survive the reshuffling. Each kind
+// is reserved to a fixed capacity up front so spawning does not allocate;
+// callers check CanAdd() to honour the overflow policy.
+class World
+{
+public:
+
+	struct AsteroidArrays
+	{
+		unsigned int Add(float x, float y,
+			float vx, float vy,
+			const XMFLOAT3 &rotationAxis,
+			float rotationSpeed,
+			int asteroidSize);
+		void Remove(unsigned int index);
+		void Clear();
+		unsigned int Size() const;
+		void Reserve(unsigned int capacity, PoolOverflowPolicy overflowPolicy);
+		bool CanAdd() const;
+
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<XMFLOAT3> axis;
+		std::vector<float> angle;
+		std::vector<float> angularSpeed;
+		std::vector<int> size;
+		std::vector<uint8_t> alive;
+		std::vector<ColliderHandle> collider;
+		std::vector<EntityHandle> handle;
+
+		HandleRegistry handles;
+		PoolOverflowPolicy policy;
+		PoolStats stats;
+	};
+
+	struct BulletArrays
+	{
+		unsigned int Add(Owner bulletOwner,
+			float x, float y,
+			float vx, float vy,
+			float life);
+		void Remove(unsigned int index);
+		void Clear();
+		unsigned int Size() const;
+		void Reserve(unsigned int capacity, PoolOverflowPolicy overflowPolicy);
+		bool CanAdd() const;
+
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<float> lifeTime;
+		std::vector<float> age;
+		std::vector<Owner> owner;
+		std::vector<uint8_t> alive;
+		std::vector<ColliderHandle> collider;
+		std::vector<EntityHandle> handle;
+
+		HandleRegistry handles;
+		PoolOverflowPolicy policy;
+		PoolStats stats;
+	};
+
+	struct ExplosionArrays
+	{
+		unsigned int Add(float x, float y, unsigned int particleEmitter);
+		void Remove(unsigned int index);
+		void Clear();
+		unsigned int Size() const;
+		void Reserve(unsigned int capacity, PoolOverflowPolicy overflowPolicy);
+		bool CanAdd() const;
+
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		// Each explosion's particles live in World::particles
+		std::vector<unsigned int> emitter;
+		std::vector<uint8_t> alive;
+		PoolOverflowPolicy policy;
+		PoolStats stats;
+	};
+
+	static const unsigned int MAX_ASTEROIDS = 256;
+	static const unsigned int MAX_BULLETS = 256;
+	static const unsigned int MAX_EXPLOSIONS = 64;
+
+	explicit World(PoolOverflowPolicy overflowPolicy = POOL_OVERFLOW_GROW);
+
+	void Clear();
+
+	AsteroidArrays asteroids;
+	BulletArrays bullets;
+	ExplosionArrays explosions;
+	ParticleSystem particles;
+};
+
+#endif // WORLD_H_INCLUDED
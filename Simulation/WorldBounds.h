@@ -0,0 +1,17 @@
+#ifndef WORLDBOUNDS_H_INCLUDED
+#define WORLDBOUNDS_H_INCLUDED
+
+// The play area. It is a torus: anything leaving one edge comes back in on
+// the opposite one, so distances are measured to the nearest wrapped image.
+struct WorldBounds
+{
+	float minX;
+	float maxX;
+	float minY;
+	float maxY;
+
+	float GetWidth() const { return maxX - minX; }
+	float GetHeight() const { return maxY - minY; }
+};
+
+#endif // WORLDBOUNDS_H_INCLUDED